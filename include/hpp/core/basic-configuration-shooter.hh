@@ -23,6 +23,7 @@
 # include <hpp/model/device.hh>
 # include <hpp/model/joint.hh>
 # include <hpp/model/joint-configuration.hh>
+# include <hpp/core/configuration-layout.hh>
 # include <hpp/core/configuration-shooter.hh>
 
 namespace hpp {
@@ -44,13 +45,37 @@ namespace hpp {
       }
       virtual ConfigurationPtr_t shoot () const
       {
-	JointVector_t jv = robot_->getJointVector ();
 	ConfigurationPtr_t config (new Configuration_t (robot_->configSize ()));
-	for (JointVector_t::const_iterator itJoint = jv.begin ();
-	     itJoint != jv.end (); itJoint++) {
-	  std::size_t rank = (*itJoint)->rankInConfiguration ();
-	  (*itJoint)->configuration ()->uniformlySample (rank, *config);
+	sample (*config);
+	return config;
+      }
+      /// Shoot random configurations without allocating them
+      virtual void shootBatch (size_type n, matrixOut_t configurations) const
+      {
+	assert (configurations.cols () >= n);
+	for (size_type i = 0; i < n; ++i) {
+	  sample (configurations.col (i));
 	}
+      }
+    protected:
+      /// Uniformly sample configuration space
+      ///
+      /// Note that translation joints have to be bounded.
+      BasicConfigurationShooter (const DevicePtr_t& robot) : robot_ (robot),
+	layout_ (ConfigurationLayout::create (robot))
+      {
+      }
+      void init (const BasicConfigurationShooterPtr_t& self)
+      {
+	ConfigurationShooter::init (self);
+	weak_ = self;
+      }
+
+    private:
+      void sample (ConfigurationOut_t config) const
+      {
+	RandomEngine& engine (*randomEngine ());
+	layout_->uniformlySample (config, engine);
 	// Shoot extra configuration variables
 	size_type extraDim = robot_->extraConfigSpace ().dimension ();
 	size_type offset = robot_->configSize () - extraDim;
@@ -65,25 +90,11 @@ namespace hpp {
 	    oss << i << ". min = " <<lower<< ", max = " << upper << std::endl;
 	    throw std::runtime_error (oss.str ());
 	  }
-	  (*config) [offset + i] = lower + (upper - lower) * rand ()/RAND_MAX;
+	  config [offset + i] = engine.uniform (lower, upper);
 	}
-	return config;
-      }
-    protected:
-      /// Uniformly sample configuration space
-      ///
-      /// Note that translation joints have to be bounded.
-      BasicConfigurationShooter (const DevicePtr_t& robot) : robot_ (robot)
-      {
-      }
-      void init (const BasicConfigurationShooterPtr_t& self)
-      {
-	ConfigurationShooter::init (self);
-	weak_ = self;
       }
-
-    private:
       const DevicePtr_t& robot_;
+      ConfigurationLayoutPtr_t layout_;
       BasicConfigurationShooterWkPtr_t weak_;
     }; // class BasicConfigurationShooter
     /// \}
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_BI_RRT_PLANNER_HH
+# define HPP_CORE_BI_RRT_PLANNER_HH
+
+# include <hpp/core/path-planner.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup path_planning
+    /// \{
+
+    /// Bidirectional RRT with greedy connection (RRT-Connect)
+    ///
+    /// The start tree is the connected component of the initial node, the
+    /// goal tree is the connected component of a goal node. At each step,
+    /// one tree is extended toward a random configuration, then the other
+    /// tree is connected toward the new node as far as the first collision.
+    /// The trees swap roles at each step.
+    class HPP_CORE_DLLAPI BiRRTPlanner : public PathPlanner
+    {
+    public:
+      /// Return shared pointer to new object.
+      static BiRRTPlannerPtr_t createWithRoadmap
+	(const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Return shared pointer to new object.
+      static BiRRTPlannerPtr_t create (const Problem& problem);
+      /// Initialize the problem resolution
+      ///
+      /// The start tree is extended first.
+      virtual void startSolve ();
+      /// One step of extension.
+      virtual void oneStep ();
+      /// Set configuration shooter.
+      void configurationShooter (const ConfigurationShooterPtr_t& shooter);
+    protected:
+      /// Constructor
+      BiRRTPlanner (const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Constructor with roadmap
+      BiRRTPlanner (const Problem& problem);
+      /// Store weak pointer to itself
+      void init (const BiRRTPlannerWkPtr_t& weak);
+      /// Extend a node in the direction of a configuration
+      /// \param near node in the roadmap,
+      /// \param target target configuration
+      /// \return the part of the path from near toward target that is
+      ///         valid, or an empty pointer if the extension failed.
+      virtual PathPtr_t extend (const NodePtr_t& near,
+				const ConfigurationPtr_t& target);
+    private:
+      /// Nearest node of the start tree or of the goal trees
+      /// \param configuration configuration to which distances are computed,
+      /// \param startTree whether to search the start tree,
+      /// \retval distance distance to the nearest node.
+      NodePtr_t nearestNode (const ConfigurationPtr_t& configuration,
+			     bool startTree, value_type& distance);
+      ConfigurationShooterPtr_t configurationShooter_;
+      mutable Configuration_t qProj_;
+      /// Whether the start tree is extended at the next step
+      bool extendStartTree_;
+      BiRRTPlannerWkPtr_t weakPtr_;
+    }; // class BiRRTPlanner
+    /// \}
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_BI_RRT_PLANNER_HH
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_CONFIGURATION_LAYOUT_HH
+# define HPP_CORE_CONFIGURATION_LAYOUT_HH
+
+# include <vector>
+# include <hpp/core/fwd.hh>
+# include <hpp/core/config.hh>
+
+namespace hpp {
+  namespace core {
+    /// Layout of the configuration vector of a robot
+    ///
+    /// The joints of the robot are visited once, when the layout is built.
+    /// Coordinates of translation joints and bounded rotation joints are
+    /// merged into segments of consecutive coordinates, on which
+    /// interpolation is a single vector operation. Other joints (unbounded
+    /// rotations, SO(3) joints) are listed separately and still handled
+    /// through their JointConfiguration.
+    ///
+    /// The extra configuration space is not part of the layout.
+    ///
+    /// \note the layout is not updated if joints are added to the robot
+    /// after it has been built.
+    class HPP_CORE_DLLAPI ConfigurationLayout
+    {
+    public:
+      /// Consecutive coordinates of vector space joints
+      struct Segment
+      {
+	Segment (size_type rank, size_type size) : rank (rank), size (size)
+	{
+	}
+	/// Rank of the first coordinate in the configuration vector
+	size_type rank;
+	/// Number of coordinates
+	size_type size;
+      }; // struct Segment
+      typedef std::vector <Segment> Segments_t;
+
+      /// Type of the joints that are not vector spaces
+      enum RotationType {
+	/// Unbounded rotation, the coordinates are the cosine and the sine
+	/// of the angle
+	SO2,
+	/// SO(3) joint, the coordinates are a unit quaternion
+	SO3,
+	/// Other joint types
+	OTHER
+      };
+
+      /// Joint that is not a vector space
+      struct Rotation
+      {
+	Rotation (const JointPtr_t& joint, size_type rank, std::size_t index,
+		  RotationType type) :
+	  joint (joint), rank (rank), index (index), type (type)
+	{
+	}
+	JointPtr_t joint;
+	/// Rank of the joint in the configuration vector
+	size_type rank;
+	/// Rank of the joint among the joints with degrees of freedom
+	std::size_t index;
+	RotationType type;
+      }; // struct Rotation
+      typedef std::vector <Rotation> Rotations_t;
+
+      /// Create the layout of the current joints of a robot
+      static ConfigurationLayoutPtr_t create (const DevicePtr_t& robot);
+
+      /// Size of the configuration vector, including the extra
+      /// configuration space
+      size_type configSize () const
+      {
+	return configSize_;
+      }
+
+      /// Segments of vector space coordinates, by increasing rank
+      const Segments_t& segments () const
+      {
+	return segments_;
+      }
+
+      /// Joints that are not vector spaces, by increasing rank
+      const Rotations_t& rotations () const
+      {
+	return rotations_;
+      }
+
+      /// Lower bounds of the coordinates when the layout was built
+      ///
+      /// Bounds of coordinates that are not bounded or that do not
+      /// belong to a joint are minus infinity.
+      const vector_t& lowerBounds () const
+      {
+	return lowerBounds_;
+      }
+
+      /// Upper bounds of the coordinates when the layout was built
+      ///
+      /// Bounds of coordinates that are not bounded or that do not
+      /// belong to a joint are plus infinity.
+      const vector_t& upperBounds () const
+      {
+	return upperBounds_;
+      }
+
+      /// Weights of the coordinates of vector space joints
+      /// \param jointWeights one weight per joint with degrees of freedom
+      ///        as stored by WeighedDistance.
+      /// \return a vector of size configSize (), the weight of each
+      ///         coordinate being the weight of its joint. Coordinates
+      ///         of rotations and of the extra configuration space have a
+      ///         zero weight.
+      vector_t coordinateWeights (const std::vector <value_type>&
+				  jointWeights) const;
+
+      /// Interpolate between two configurations
+      /// \param q1, q2 configurations,
+      /// \param u interpolation parameter in [0,1],
+      /// \retval result interpolated configuration. Coordinates of the
+      ///         extra configuration space are not modified.
+      void interpolate (ConfigurationIn_t q1, ConfigurationIn_t q2,
+			const value_type& u, ConfigurationOut_t result) const;
+
+      /// Uniformly sample the coordinates of the joints
+      ///
+      /// \param engine random number generator.
+      /// Bounds are read from the joints at each call, since they may be
+      /// modified after the layout has been built.
+      /// Coordinates of the extra configuration space are not modified.
+      /// Joints of type OTHER are sampled by their JointConfiguration,
+      /// which does not use the engine.
+      /// \throw std::runtime_error if a vector space coordinate is not
+      ///        bounded.
+      void uniformlySample (ConfigurationOut_t q, RandomEngine& engine) const;
+
+      /// Map three numbers of [0,1] to a unit quaternion
+      ///
+      /// \param u1, u2, u3 numbers in [0,1],
+      /// \param rank rank of the first coordinate of the quaternion,
+      /// \retval q configuration in which the quaternion is written.
+      /// Uniformly distributed numbers give uniformly distributed
+      /// quaternions (Shoemake). The distribution is invariant by
+      /// permutation of the coordinates, hence does not depend on their
+      /// order.
+      static void uniformQuaternion (value_type u1, value_type u2,
+				     value_type u3, size_type rank,
+				     ConfigurationOut_t q);
+
+    protected:
+      ConfigurationLayout (const DevicePtr_t& robot);
+
+    private:
+      size_type configSize_;
+      Segments_t segments_;
+      Rotations_t rotations_;
+      /// Vector space joints and their rank among the joints with degrees
+      /// of freedom
+      std::vector <std::pair <JointPtr_t, std::size_t> > linearJoints_;
+      vector_t lowerBounds_;
+      vector_t upperBounds_;
+    }; // class ConfigurationLayout
+  } //   namespace core
+} // namespace hpp
+#endif // HPP_CORE_CONFIGURATION_LAYOUT_HH
@@ -21,6 +21,7 @@
 
 # include <hpp/core/config.hh>
 # include <hpp/core/fwd.hh>
+# include <hpp/core/random-engine.hh>
 
 namespace hpp {
   namespace core {
@@ -36,8 +37,35 @@ namespace hpp {
     public:
       /// Shoot a random configuration
       virtual ConfigurationPtr_t shoot () const = 0;
+      /// Shoot random configurations
+      ///
+      /// \param n number of configurations,
+      /// \retval configurations matrix the columns of which are filled with
+      ///         the configurations. The matrix should have n columns and
+      ///         as many rows as the configuration size.
+      /// The default implementation copies the result of shoot. Derived
+      /// classes can avoid the allocation of each configuration.
+      virtual void shootBatch (size_type n, matrixOut_t configurations) const
+      {
+	assert (configurations.cols () >= n);
+	for (size_type i = 0; i < n; ++i) {
+	  configurations.col (i) = *shoot ();
+	}
+      }
+      /// Set the random number generator
+      ///
+      /// Problem::configurationShooter sets the engine of the problem.
+      void randomEngine (const RandomEnginePtr_t& randomEngine)
+      {
+	randomEngine_ = randomEngine;
+      }
+      /// Get the random number generator
+      const RandomEnginePtr_t& randomEngine () const
+      {
+	return randomEngine_;
+      }
     protected:
-      ConfigurationShooter ()
+      ConfigurationShooter () : randomEngine_ (RandomEngine::create ())
     {
     }
       /// Store weak pointer to itself
@@ -46,6 +74,7 @@ namespace hpp {
   weakPtr_ = weak;
     }
     private:
+      RandomEnginePtr_t randomEngine_;
       ConfigurationShooterWkPtr_t weakPtr_;
     }; // class
   } //   namespace core
@@ -45,8 +45,25 @@ namespace hpp {
       ///
       /// \param other connected component to merge into this one.
       /// \note other will be empty after calling this method.
+      ///
+      /// The nodes of other are not visited: other only records that it
+      /// has been merged into this connected component, and nodes find
+      /// their connected component through representative ().
       void merge (const ConnectedComponentPtr_t& other);
 
+      /// Whether this connected component has been merged into another one
+      bool merged () const
+      {
+	return parent_.get () != NULL;
+      }
+
+      /// Connected component this one has been merged into
+      ///
+      /// Merged connected components form a union-find forest, the root
+      /// of which is returned. Paths are compressed on the way. Return
+      /// this connected component if it has not been merged.
+      ConnectedComponentPtr_t representative ();
+
       /// Add node in connected component
       /// \param node node to add.
       void addNode (const NodePtr_t& node)
@@ -85,10 +102,21 @@ namespace hpp {
       {
 	return reachableFrom_;
       }
+
+      /// Whether a goal node of the roadmap can be reached from this
+      /// connected component
+      ///
+      /// Kept up to date by the roadmap as goal nodes and edges are added,
+      /// so that Roadmap::pathExists does not search the graph.
+      bool canReachGoal () const
+      {
+	return canReachGoal_;
+      }
       /// \}
     protected:
       /// Constructor
-      ConnectedComponent () : nodes_ (), explored_ (false), weak_ ()
+      ConnectedComponent () : nodes_ (), reachableFrom_ (), reachableTo_ (),
+	parent_ (), canReachGoal_ (false), explored_ (false), weak_ ()
 	  {
 	  }
       void init (const ConnectedComponentPtr_t& shPtr){
@@ -100,11 +128,16 @@ namespace hpp {
       ConnectedComponents_t reachableFrom_;
       // List of CCs that can be reached from this connected component
       ConnectedComponents_t reachableTo_;
+      // Connected component this one has been merged into, if any
+      ConnectedComponentPtr_t parent_;
+      // whether a goal node can be reached from this connected component
+      bool canReachGoal_;
       // status variable to indicate whether or not CC has been visited
       mutable bool explored_;
       ConnectedComponentWkPtr_t weak_;
+      // Mark explored connected components as unexplored.
+      static void clean (std::vector <ConnectedComponent*>& explored);
       friend class Roadmap;
-      friend void clean (ConnectedComponents_t& set);
     }; // class ConnectedComponent
   } //   namespace core
 } // namespace hpp
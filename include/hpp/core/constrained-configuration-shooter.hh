@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_CONSTRAINED_CONFIGURATION_SHOOTER_HH
+# define HPP_CORE_CONSTRAINED_CONFIGURATION_SHOOTER_HH
+
+# include <vector>
+# include <hpp/core/configuration-layout.hh>
+# include <hpp/core/configuration-shooter.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup configuration_sampling
+    /// \{
+
+    /// Sample the degrees of freedom that are not determined by constraints
+    ///
+    /// The constraints are read from the ConfigProjector of a constraint
+    /// set when the shooter is created:
+    /// \li coordinates of locked joints are set to their locked values,
+    /// \li output coordinates of explicit numerical constraints are
+    ///     computed from the input coordinates,
+    /// \li other coordinates are sampled uniformly, as by
+    ///     BasicConfigurationShooter.
+    ///
+    /// The configurations still need to be projected on the implicit
+    /// constraints, but the projection starts closer to the solution and
+    /// fails less often than from a configuration sampled over all joints.
+    class HPP_CORE_DLLAPI ConstrainedConfigurationShooter :
+      public ConfigurationShooter
+    {
+    public:
+      /// Return shared pointer to new object.
+      /// \param robot the robot,
+      /// \param constraints constraint set, may be empty.
+      static ConstrainedConfigurationShooterPtr_t create
+	(const DevicePtr_t& robot, const ConstraintSetPtr_t& constraints);
+      /// Shoot a configuration
+      virtual ConfigurationPtr_t shoot () const;
+      /// Shoot configurations without allocating them
+      virtual void shootBatch (size_type n, matrixOut_t configurations) const;
+      /// Number of sampled coordinates of vector space joints and of the
+      /// extra configuration space
+      std::size_t numberFreeCoordinates () const
+      {
+	return free_.size ();
+      }
+    protected:
+      /// \throw std::runtime_error if a sampled coordinate is not bounded.
+      ConstrainedConfigurationShooter (const DevicePtr_t& robot,
+				       const ConstraintSetPtr_t& constraints);
+      void init (const ConstrainedConfigurationShooterPtr_t& self);
+    private:
+      void sample (ConfigurationOut_t q) const;
+
+      DevicePtr_t robot_;
+      ConfigurationLayoutPtr_t layout_;
+      /// Ranks and bounds of the sampled coordinates of vector spaces
+      std::vector <size_type> free_;
+      vector_t lower_, upper_;
+      /// Rotations that are not locked nor output of explicit constraints
+      ConfigurationLayout::Rotations_t rotations_;
+      LockedJoints_t lockedJoints_;
+      std::vector <ExplicitNumericalConstraintPtr_t> explicitConstraints_;
+      ConstrainedConfigurationShooterWkPtr_t weak_;
+    }; // class ConstrainedConfigurationShooter
+    /// \}
+  } //   namespace core
+} // namespace hpp
+
+#endif // HPP_CORE_CONSTRAINED_CONFIGURATION_SHOOTER_HH
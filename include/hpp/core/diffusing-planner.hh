@@ -19,6 +19,8 @@
 #ifndef HPP_CORE_DIFFUSING_PLANNER_HH
 # define HPP_CORE_DIFFUSING_PLANNER_HH
 
+# include <string>
+# include <vector>
 # include <hpp/core/path-planner.hh>
 
 namespace hpp {
@@ -39,6 +41,21 @@ namespace hpp {
       virtual void oneStep ();
       /// Set configuration shooter.
       void configurationShooter (const ConfigurationShooterPtr_t& shooter);
+      /// Set path validation methods used to validate paths in parallel
+      ///
+      /// Extensions of the connected components and connections between
+      /// new nodes are validated by one thread per path validation
+      /// method. The threads are created here and kept alive between
+      /// steps. Since validation modifies the configuration of the robot,
+      /// each method should work on its own copy of the robot, as the
+      /// methods returned by Problem::pathValidations.
+      ///
+      /// Paths are validated sequentially by the path validation of the
+      /// problem if the vector is empty (default) or if the steering method
+      /// has a ConfigProjector, whose state is shared by all paths.
+      ///
+      /// The roadmap does not depend on the number of threads.
+      void pathValidations (const PathValidations_t& pathValidations);
     protected:
       /// Constructor
       DiffusingPlanner (const Problem& problem, const RoadmapPtr_t& roadmap);
@@ -52,7 +69,29 @@ namespace hpp {
       virtual PathPtr_t extend (const NodePtr_t& near,
 				const ConfigurationPtr_t& target);
     private:
+      /// Path to validate and result of its validation
+      struct ValidationTask
+      {
+	ValidationTask (const PathPtr_t& path) :
+	  path (path), valid (false), validPart (), error ()
+	{
+	}
+	PathPtr_t path;
+	bool valid;
+	PathPtr_t validPart;
+	/// Message of the exception thrown by the validation, if any
+	std::string error;
+      }; // struct ValidationTask
+      typedef std::vector <ValidationTask> ValidationTasks_t;
+      /// Validate the paths of a set of tasks
+      void validate (ValidationTasks_t& tasks) const;
+      /// Validate the tasks of rank thread modulo the number of threads
+      void validateTasks (ValidationTasks_t* tasks, std::size_t thread,
+			  std::size_t threads) const;
       ConfigurationShooterPtr_t configurationShooter_;
+      PathValidations_t pathValidations_;
+      /// One worker per path validation method
+      ThreadPoolPtr_t threadPool_;
       mutable Configuration_t qProj_;
       DiffusingPlannerWkPtr_t weakPtr_;
     };
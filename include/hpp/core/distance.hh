@@ -37,6 +37,35 @@ namespace hpp {
 	return impl_distance (q1, q2);
       }
 
+      /// Distances between a configuration and a set of configurations
+      /// \param q configuration,
+      /// \param configurations one configuration per column,
+      /// \retval distances distance between q and each column of
+      ///         configurations, resized by the caller.
+      ///
+      /// Derived class may override this method with a vectorized version.
+      virtual void compute (ConfigurationIn_t q,
+			    const matrixIn_t& configurations,
+			    vectorOut_t distances) const
+      {
+	assert (distances.size () == configurations.cols ());
+	for (size_type i = 0; i < configurations.cols (); ++i) {
+	  distances [i] = impl_distance (q, configurations.col (i));
+	}
+      }
+
+      /// Lower bound of the distance between two configurations
+      ///
+      /// Nearest neighbor methods compute this bound first in order to
+      /// discard the candidates that are obviously too far away. It should
+      /// thus be much cheaper than the distance itself.
+      /// \return 0 by default, derived class may provide a better bound.
+      virtual value_type lowerBound (ConfigurationIn_t,
+				     ConfigurationIn_t) const
+      {
+	return 0;
+      }
+
       virtual DistancePtr_t clone () const = 0;
       
     protected:
@@ -23,6 +23,7 @@
 # include <vector>
 # include <deque>
 # include <list>
+# include <map>
 # include <set>
 # include <hpp/util/pointer.hh>
 # include <hpp/constraints/fwd.hh>
@@ -30,15 +31,18 @@
 namespace hpp {
   namespace core {
     HPP_PREDEF_CLASS (BasicConfigurationShooter);
+    HPP_PREDEF_CLASS (BiRRTPlanner);
     HPP_PREDEF_CLASS (CollisionPathValidation);
     struct CollisionPathValidationReport;
     HPP_PREDEF_CLASS (CollisionValidation);
     HPP_PREDEF_CLASS (CollisionValidationReport);
+    HPP_PREDEF_CLASS (ConfigurationLayout);
     HPP_PREDEF_CLASS (ConfigurationShooter);
     HPP_PREDEF_CLASS (ConfigProjector);
     HPP_PREDEF_CLASS (ConfigValidation);
     HPP_PREDEF_CLASS (ConfigValidations);
     HPP_PREDEF_CLASS (ConnectedComponent);
+    HPP_PREDEF_CLASS (ConstrainedConfigurationShooter);
     HPP_PREDEF_CLASS (Constraint);
     HPP_PREDEF_CLASS (ConstraintSet);
     HPP_PREDEF_CLASS (DiffusingPlanner);
@@ -49,6 +53,8 @@ namespace hpp {
     HPP_PREDEF_CLASS (ExplicitNumericalConstraint);
     HPP_PREDEF_CLASS (ExplicitRelativeTransformation);
     HPP_PREDEF_CLASS (NumericalConstraint);
+    HPP_PREDEF_CLASS (HaltonConfigurationShooter);
+    HPP_PREDEF_CLASS (LazyPrmPlanner);
     HPP_PREDEF_CLASS (LockedJoint);
     class Edge;
     HPP_PREDEF_CLASS (ExtractedPath);
@@ -58,6 +64,7 @@ namespace hpp {
     HPP_PREDEF_CLASS (Path);
     HPP_PREDEF_CLASS (PathOptimizer);
     HPP_PREDEF_CLASS (PathPlanner);
+    HPP_PREDEF_CLASS (PrmStarPlanner);
     HPP_PREDEF_CLASS (PathVector);
     HPP_PREDEF_CLASS (PathValidation);
     struct PathValidationReport;
@@ -65,12 +72,15 @@ namespace hpp {
     HPP_PREDEF_CLASS (PlanAndOptimize);
     HPP_PREDEF_CLASS (Problem);
     class ProblemSolver;
+    HPP_PREDEF_CLASS (RandomEngine);
     HPP_PREDEF_CLASS (RandomShortcut);
     HPP_PREDEF_CLASS (Roadmap);
     HPP_PREDEF_CLASS (SteeringMethod);
     HPP_PREDEF_CLASS (SteeringMethodStraight);
     HPP_PREDEF_CLASS (StraightPath);
     HPP_PREDEF_CLASS (InterpolatedPath);
+    HPP_PREDEF_CLASS (ThreadPool);
+    HPP_PREDEF_CLASS (ValidationContext);
     HPP_PREDEF_CLASS (ValidationReport);
     HPP_PREDEF_CLASS (VisibilityPrmPlanner);
     HPP_PREDEF_CLASS (WeighedDistance);
@@ -95,6 +105,7 @@ namespace hpp {
     CollisionPathValidationReportPtr_t;
     typedef std::vector <CollisionPathValidationReport> 
     CollisionPathValidationReports_t;
+    typedef boost::shared_ptr <BiRRTPlanner> BiRRTPlannerPtr_t;
     typedef boost::shared_ptr <CollisionValidation> CollisionValidationPtr_t;
     typedef boost::shared_ptr <CollisionValidationReport>
     CollisionValidationReportPtr_t;
@@ -106,6 +117,7 @@ namespace hpp {
     typedef std::vector <ConfigurationPtr_t> Configurations_t;
     typedef Configurations_t::iterator ConfigIterator_t;
     typedef Configurations_t::const_iterator ConfigConstIterator_t;
+    typedef boost::shared_ptr <ConfigurationLayout> ConfigurationLayoutPtr_t;
     typedef boost::shared_ptr <ConfigurationShooter> ConfigurationShooterPtr_t;
     typedef boost::shared_ptr <ConfigProjector> ConfigProjectorPtr_t;
     typedef boost::shared_ptr <ConfigValidation> ConfigValidationPtr_t;
@@ -114,6 +126,8 @@ namespace hpp {
     typedef std::set <ConnectedComponentPtr_t> ConnectedComponents_t;
     typedef boost::shared_ptr <Constraint> ConstraintPtr_t;
     typedef boost::shared_ptr <ConstraintSet> ConstraintSetPtr_t;
+    typedef boost::shared_ptr <ConstrainedConfigurationShooter>
+    ConstrainedConfigurationShooterPtr_t;
     typedef boost::shared_ptr <const ConstraintSet> ConstraintSetConstPtr_t;
     typedef std::deque <ConstraintPtr_t> Constraints_t;
     typedef model::Device Device_t;
@@ -139,6 +153,8 @@ namespace hpp {
     typedef boost::shared_ptr <ExplicitRelativeTransformation>
     ExplicitRelativeTransformationPtr_t;
     typedef boost::shared_ptr <ExtractedPath> ExtractedPathPtr_t;
+    typedef boost::shared_ptr <HaltonConfigurationShooter>
+    HaltonConfigurationShooterPtr_t;
     typedef model::JointJacobian_t JointJacobian_t;
     typedef model::Joint Joint;
     typedef model::JointConstPtr_t JointConstPtr_t;
@@ -149,6 +165,7 @@ namespace hpp {
     typedef model::HalfJointJacobian_t HalfJointJacobian_t;
     typedef model::JointVector_t JointVector_t;
     typedef KDTree* KDTreePtr_t;
+    typedef boost::shared_ptr <LazyPrmPlanner> LazyPrmPlannerPtr_t;
     typedef boost::shared_ptr <LockedJoint> LockedJointPtr_t;
     typedef boost::shared_ptr <Equation> EquationPtr_t;
     typedef boost::shared_ptr <const LockedJoint> LockedJointConstPtr_t;
@@ -166,18 +183,25 @@ namespace hpp {
     typedef std::vector < SizeIntervals_t > IntervalsContainer_t;
     typedef std::list <Node*> Nodes_t;
     typedef Node* NodePtr_t;
+    /// Nearest node and distance to this node in each connected component
+    typedef std::map <ConnectedComponentPtr_t, std::pair <NodePtr_t,
+							  value_type> >
+    NearestNodes_t;
     typedef model::ObjectVector_t ObjectVector_t;
     typedef boost::shared_ptr <Path> PathPtr_t;
     typedef boost::shared_ptr <const Path> PathConstPtr_t;
     typedef boost::shared_ptr <PathOptimizer> PathOptimizerPtr_t;
     typedef boost::shared_ptr <PathPlanner> PathPlannerPtr_t;
+    typedef boost::shared_ptr <PrmStarPlanner> PrmStarPlannerPtr_t;
     typedef boost::shared_ptr <PathValidation> PathValidationPtr_t;
+    typedef std::vector <PathValidationPtr_t> PathValidations_t;
     typedef boost::shared_ptr <PathValidationReport> PathValidationReportPtr_t;
     typedef boost::shared_ptr <PathVector> PathVectorPtr_t;
     typedef boost::shared_ptr <const PathVector> PathVectorConstPtr_t;
     typedef boost::shared_ptr <PlanAndOptimize> PlanAndOptimizePtr_t;
     typedef Problem* ProblemPtr_t;
     typedef ProblemSolver* ProblemSolverPtr_t;
+    typedef boost::shared_ptr <RandomEngine> RandomEnginePtr_t;
     typedef boost::shared_ptr <RandomShortcut> RandomShortcutPtr_t;
     typedef boost::shared_ptr <Roadmap> RoadmapPtr_t;
     typedef boost::shared_ptr <StraightPath> StraightPathPtr_t;
@@ -187,6 +211,7 @@ namespace hpp {
     typedef boost::shared_ptr <SteeringMethod> SteeringMethodPtr_t;
     typedef boost::shared_ptr <SteeringMethodStraight>
     SteeringMethodStraightPtr_t;
+    typedef boost::shared_ptr <ThreadPool> ThreadPoolPtr_t;
     typedef std::vector <PathPtr_t> Paths_t;
     typedef std::vector <PathVectorPtr_t> PathVectors_t;
     typedef std::vector <PathVectorPtr_t> PathVectors_t;
@@ -197,6 +222,8 @@ namespace hpp {
     typedef model::vectorOut_t vectorOut_t;
     typedef Eigen::Matrix<value_type, 1, Eigen::Dynamic> rowvector_t;
     typedef boost::shared_ptr <VisibilityPrmPlanner> VisibilityPrmPlannerPtr_t;
+    typedef boost::shared_ptr <ValidationContext> ValidationContextPtr_t;
+    typedef std::vector <ValidationContextPtr_t> ValidationContexts_t;
     typedef boost::shared_ptr <ValidationReport> ValidationReportPtr_t;
     typedef boost::shared_ptr <WeighedDistance> WeighedDistancePtr_t;
     typedef std::map <std::string, NumericalConstraintPtr_t>
@@ -220,8 +247,8 @@ namespace hpp {
       typedef boost::shared_ptr <Progressive> ProgressivePtr_t;
     } // namespace continuousCollisionChecking
 
-    class NearestNeighbor;
-    typedef NearestNeighbor* NearestNeighborPtr_t;
+    HPP_PREDEF_CLASS (NearestNeighbor);
+    typedef boost::shared_ptr <NearestNeighbor> NearestNeighborPtr_t;
     namespace nearestNeighbor {
       class Basic;
       class KDTree;
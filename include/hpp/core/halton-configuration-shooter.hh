@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_HALTON_CONFIGURATION_SHOOTER_HH
+# define HPP_CORE_HALTON_CONFIGURATION_SHOOTER_HH
+
+# include <vector>
+# include <hpp/core/configuration-shooter.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup configuration_sampling
+    /// \{
+
+    /// Sample configurations with a randomized Halton sequence
+    ///
+    /// The points of a Halton sequence cover the unit cube more evenly
+    /// than uniformly random points: fewer samples are needed to reach
+    /// every region of the configuration space.
+    ///
+    /// Each dimension of the sequence is mapped to a parameter of the
+    /// configuration space:
+    /// \li one dimension per coordinate of translations and bounded
+    ///     rotations, scaled to the bounds,
+    /// \li one dimension per unbounded rotation, scaled to an angle in
+    ///     \f$[-\pi,\pi]\f$ and stored as its cosine and sine,
+    /// \li three dimensions per SO(3) joint, mapped to a unit quaternion by
+    ///     ConfigurationLayout::uniformQuaternion,
+    /// \li one dimension per coordinate of the extra configuration space.
+    /// Other joints are sampled at random by their JointConfiguration.
+    ///
+    /// The sequence is shifted by a random vector drawn from the random
+    /// engine (Cranley-Patterson rotation), so that shooters with
+    /// different engines produce different sequences.
+    class HPP_CORE_DLLAPI HaltonConfigurationShooter :
+      public ConfigurationShooter
+    {
+    public:
+      /// Return shared pointer to new object.
+      static HaltonConfigurationShooterPtr_t create (const DevicePtr_t& robot);
+      /// Shoot the next configuration of the sequence
+      virtual ConfigurationPtr_t shoot () const;
+      /// Shoot the next n configurations of the sequence
+      virtual void shootBatch (size_type n, matrixOut_t configurations) const;
+      /// Restart the sequence
+      ///
+      /// The random shift is drawn again from the random engine.
+      void reset ();
+      /// Number of dimensions of the sequence
+      std::size_t dimension () const
+      {
+	return primes_.size ();
+      }
+    protected:
+      /// Bounds are read from the joints when the shooter is created.
+      /// \throw std::runtime_error if a translation or an extra
+      ///        configuration variable is not bounded.
+      HaltonConfigurationShooter (const DevicePtr_t& robot);
+      void init (const HaltonConfigurationShooterPtr_t& self);
+    private:
+      /// Write the next point of the sequence in a configuration
+      void sample (ConfigurationOut_t q) const;
+      /// Coordinate of the current point along a dimension of the sequence
+      value_type coordinate (std::size_t dimension) const;
+
+      DevicePtr_t robot_;
+      ConfigurationLayoutPtr_t layout_;
+      /// Bounds of the coordinates mapped linearly to the sequence
+      vector_t lower_, upper_;
+      /// Base of each dimension of the sequence
+      std::vector <std::size_t> primes_;
+      /// Random shift of each dimension
+      mutable vector_t shift_;
+      /// Whether shift_ has been drawn
+      mutable bool shifted_;
+      /// Index of the last point of the sequence
+      mutable std::size_t index_;
+      HaltonConfigurationShooterWkPtr_t weak_;
+    }; // class HaltonConfigurationShooter
+    /// \}
+  } //   namespace core
+} // namespace hpp
+
+#endif // HPP_CORE_HALTON_CONFIGURATION_SHOOTER_HH
@@ -48,6 +48,8 @@ namespace hpp {
       /// \param device Robot corresponding to configurations
       /// \param init, end Start and end configurations of the path
       /// \param length Distance between the configurations.
+      /// \note the layout of the configurations is built for each path,
+      ///       the overload taking a layout avoids it.
       static InterpolatedPathPtr_t create (const DevicePtr_t& device,
 				       ConfigurationIn_t init,
 				       ConfigurationIn_t end,
@@ -64,6 +66,8 @@ namespace hpp {
       /// \param init, end Start and end configurations of the path
       /// \param length Distance between the configurations.
       /// \param constraints the path is subject to
+      /// \note the layout of the configurations is built for each path,
+      ///       the overload taking a layout avoids it.
       static InterpolatedPathPtr_t create (const DevicePtr_t& device,
 				       ConfigurationIn_t init,
 				       ConfigurationIn_t end,
@@ -77,6 +81,27 @@ namespace hpp {
 	return shPtr;
       }
 
+      /// Create instance and return shared pointer
+      /// \param device Robot corresponding to configurations
+      /// \param init, end Start and end configurations of the path
+      /// \param length Distance between the configurations.
+      /// \param constraints the path is subject to
+      /// \param layout layout of the configurations of the robot, shared
+      ///        between the paths of a steering method.
+      static InterpolatedPathPtr_t create (const DevicePtr_t& device,
+				       ConfigurationIn_t init,
+				       ConfigurationIn_t end,
+				       value_type length,
+				       ConstraintSetPtr_t constraints,
+				       const ConfigurationLayoutPtr_t& layout)
+      {
+	InterpolatedPath* ptr = new InterpolatedPath (device, init, end, length,
+					      constraints, layout);
+	InterpolatedPathPtr_t shPtr (ptr);
+	ptr->init (shPtr);
+	return shPtr;
+      }
+
       /// Create copy and return shared pointer
       /// \param path path to copy
       static InterpolatedPathPtr_t createCopy (const InterpolatedPathPtr_t& path)
@@ -178,6 +203,12 @@ namespace hpp {
 		    ConfigurationIn_t end, value_type length,
 		    ConstraintSetPtr_t constraints);
 
+      /// Constructor with constraints and layout
+      InterpolatedPath (const DevicePtr_t& robot, ConfigurationIn_t init,
+		    ConfigurationIn_t end, value_type length,
+		    ConstraintSetPtr_t constraints,
+		    const ConfigurationLayoutPtr_t& layout);
+
       /// Copy constructor
       InterpolatedPath (const InterpolatedPath& path);
 
@@ -196,6 +227,7 @@ namespace hpp {
       inline void checkPath () const;
 
       DevicePtr_t device_;
+      ConfigurationLayoutPtr_t layout_;
       InterpolationPoints_t configs_;
       InterpolatedPathWkPtr_t weak_;
     }; // class InterpolatedPath
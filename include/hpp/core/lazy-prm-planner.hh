@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_LAZY_PRM_PLANNER_HH
+# define HPP_CORE_LAZY_PRM_PLANNER_HH
+
+# include <vector>
+# include <hpp/core/path-planner.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup path_planning
+    /// \{
+
+    /// Lazy PRM algorithm
+    ///
+    /// Each new configuration is connected to its nearest nodes by
+    /// candidate edges that are not validated. Candidate edges are stored
+    /// by the planner, the roadmap only contains validated edges.
+    ///
+    /// At each step, the shortest path from the initial node to a goal
+    /// node is searched in the graph made of the edges of the roadmap and
+    /// of the candidate edges. Only the candidate edges along this path
+    /// are validated: valid edges are inserted in the roadmap, invalid
+    /// ones are discarded and the search is run again, until a path made
+    /// of valid edges is found or no path remains.
+    class HPP_CORE_DLLAPI LazyPrmPlanner : public PathPlanner
+    {
+    public:
+      /// Return shared pointer to new object.
+      static LazyPrmPlannerPtr_t createWithRoadmap
+	(const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Return shared pointer to new object.
+      static LazyPrmPlannerPtr_t create (const Problem& problem);
+      /// Initialize the problem resolution
+      ///
+      /// Candidate edges of a previous resolution are discarded.
+      virtual void startSolve ();
+      /// One step of extension.
+      virtual void oneStep ();
+      /// Set configuration shooter.
+      void configurationShooter (const ConfigurationShooterPtr_t& shooter);
+      /// Set the number of nearest nodes a new node is connected to
+      void numberOfNeighbors (std::size_t k)
+      {
+	numberOfNeighbors_ = k;
+      }
+      /// Get the number of nearest nodes a new node is connected to
+      std::size_t numberOfNeighbors () const
+      {
+	return numberOfNeighbors_;
+      }
+    protected:
+      /// Constructor
+      LazyPrmPlanner (const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Constructor with roadmap
+      LazyPrmPlanner (const Problem& problem);
+      /// Store weak pointer to itself
+      void init (const LazyPrmPlannerWkPtr_t& weak);
+    private:
+      /// Status of a candidate edge
+      enum EdgeStatus {
+	UNKNOWN,
+	VALID,
+	INVALID
+      };
+      /// Candidate edge between two nodes, in both directions
+      struct CandidateEdge
+      {
+	CandidateEdge (std::size_t n1, std::size_t n2, value_type cost) :
+	  n1 (n1), n2 (n2), cost (cost), status (UNKNOWN)
+	{
+	}
+	std::size_t n1;
+	std::size_t n2;
+	/// Distance between the configurations of the nodes
+	value_type cost;
+	EdgeStatus status;
+      }; // struct CandidateEdge
+      typedef std::vector <CandidateEdge> CandidateEdges_t;
+
+      /// Register the nodes added to the roadmap since the last call and
+      /// create their candidate edges.
+      /// \return whether a new candidate edge reaches a node reachable from
+      ///         the initial node. Otherwise, no new path to a goal node
+      ///         exists since the last search failed.
+      bool addCandidateEdges ();
+      /// Search the shortest path from the initial node to a goal node
+      /// \retval candidates candidate edges along the path, from the
+      ///         initial node to the goal node.
+      /// \return whether a path has been found. If not, the nodes reachable
+      ///         from the initial node are stored.
+      bool shortestPath (std::vector <std::size_t>& candidates);
+      /// Validate a candidate edge and insert it in the roadmap if valid
+      bool validate (CandidateEdge& edge);
+
+      ConfigurationShooterPtr_t configurationShooter_;
+      std::size_t numberOfNeighbors_;
+      /// Nodes of the roadmap indexed by Node::index
+      std::vector <NodePtr_t> nodes_;
+      CandidateEdges_t edges_;
+      /// Indices in edges_ of the candidate edges of each node
+      std::vector <std::vector <std::size_t> > adjacency_;
+      /// Nodes reachable from the initial node when the last search failed,
+      /// empty if no search failed since startSolve.
+      std::vector <bool> reached_;
+      LazyPrmPlannerWkPtr_t weakPtr_;
+    }; // class LazyPrmPlanner
+    /// \}
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_LAZY_PRM_PLANNER_HH
@@ -29,11 +29,58 @@ namespace hpp {
     public:
       virtual void clear () = 0;
       virtual void addNode (const NodePtr_t& node) = 0;
+
+      /// Replace the content of the structure by a set of nodes
+      ///
+      /// Structures that can be built more efficiently from a whole set of
+      /// nodes than by successive insertions reimplement this method.
+      virtual void build (const Nodes_t& nodes) = 0;
+
       virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
 			       const ConnectedComponentPtr_t&
 				connectedComponent,
 			       value_type& distance) = 0;
 
+      /// Search the nearest node in the whole roadmap
+      /// \param configuration configuration to which distances are computed,
+      /// \retval distance distance to the nearest node.
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				value_type& distance) = 0;
+
+      /// Search the nearest node of each connected component in one pass
+      /// \param configuration configuration to which distances are computed,
+      /// \retval nearest nearest node and distance for each connected
+      ///         component containing at least one node.
+      virtual void search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest) = 0;
+
+      /// Return the k nearest nodes of a connected component
+      /// \param configuration configuration to which distances are computed,
+      /// \param connectedComponent connected component the nodes belong to,
+      /// \param k maximal number of nodes to return.
+      /// \return nodes sorted by increasing distance to configuration.
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k) = 0;
+
+      /// Return the k nearest nodes of the whole roadmap
+      /// \param configuration configuration to which distances are computed,
+      /// \param k maximal number of nodes to return.
+      /// \return nodes sorted by increasing distance to configuration.
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k) = 0;
+
+      /// Return the nodes of a connected component within a given distance
+      /// \param configuration configuration to which distances are computed,
+      /// \param connectedComponent connected component the nodes belong to,
+      /// \param maxDistance radius of the ball centered at configuration.
+      /// \return nodes sorted by increasing distance to configuration.
+      virtual Nodes_t withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance) = 0;
+
       // merge two connected components in the whole tree
       virtual void merge (ConnectedComponentPtr_t cc1,
 			  ConnectedComponentPtr_t cc2) = 0;
@@ -41,6 +88,25 @@ namespace hpp {
       // Get distance function
       virtual DistancePtr_t distance () const = 0;
 
+      /// Set the matrix storing the configurations of the nodes
+      ///
+      /// Column i is the configuration of the node of index i (see
+      /// Node::index). Configurations are read from this matrix and are
+      /// not copied: the nodes of the structure must be the nodes of the
+      /// roadmap owning the matrix, inserted by increasing index.
+      /// Roadmap::nearestNeighbor sets the matrix of the roadmap.
+      void configurations (const matrix_t& configurations)
+      {
+	configurations_ = &configurations;
+      }
+
+    protected:
+      NearestNeighbor () : configurations_ (0)
+      {
+      }
+
+      /// Configurations of the nodes, owned by the roadmap
+      const matrix_t* configurations_;
     }; // class NearestNeighbor
   } // namespace core
 } // namespace hpp
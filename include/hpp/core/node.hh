@@ -48,19 +48,50 @@ namespace hpp {
       void addInEdge (EdgePtr_t edge);
       /// Store the connected component the node belongs to
       void connectedComponent (const ConnectedComponentPtr_t& cc);
+      /// Get the connected component the node belongs to
+      ///
+      /// The node is not notified when its connected component is merged
+      /// into another one: the stored connected component is replaced by
+      /// its representative when it is accessed.
       ConnectedComponentPtr_t connectedComponent () const;
       /// Access to outEdges
       const Edges_t& outEdges () const;
       /// Access to inEdges
       const Edges_t& inEdges () const;
       ConfigurationPtr_t configuration () const;
+      /// Index of the node in the roadmap
+      ///
+      /// Nodes are indexed from 0 in the order they are added to the
+      /// roadmap. The index is also the column of the configuration of the
+      /// node in Roadmap::configurations ().
+      std::size_t index () const
+      {
+	return index_;
+      }
+      /// Set index of the node in the roadmap
+      void index (std::size_t index)
+      {
+	index_ = index;
+      }
+      /// Whether the node is a goal node of the roadmap
+      bool isGoal () const
+      {
+	return isGoal_;
+      }
+      /// Set whether the node is a goal node of the roadmap
+      void isGoal (bool isGoal)
+      {
+	isGoal_ = isGoal;
+      }
       /// Print node in a stream
       std::ostream& print (std::ostream& os) const;
     private:
       ConfigurationPtr_t configuration_;
       Edges_t outEdges_;
       Edges_t inEdges_;
-      ConnectedComponentPtr_t connectedComponent_;
+      mutable ConnectedComponentPtr_t connectedComponent_;
+      std::size_t index_;
+      bool isGoal_;
     }; // class Node
     std::ostream& operator<< (std::ostream& os, const Node& n);
     /// \}
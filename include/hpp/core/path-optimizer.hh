@@ -19,6 +19,8 @@
 #ifndef HPP_CORE_PATH_OPTIMIZER_HH
 # define HPP_CORE_PATH_OPTIMIZER_HH
 
+# include <limits>
+# include <boost/date_time/posix_time/posix_time_types.hpp>
 # include <hpp/core/config.hh>
 # include <hpp/core/fwd.hh>
 
@@ -41,20 +43,43 @@ namespace hpp {
       virtual PathVectorPtr_t optimize (const PathVectorPtr_t& path) = 0;
       /// Interrupt path optimization
       void interrupt () { interrupt_ = true; }
+      /// Limit the duration of optimization
+      ///
+      /// \param maxTime maximal duration in seconds, counted from this
+      ///        call. Infinity (default) removes the limit.
+      /// When the duration is exceeded, optimizers stop iterating and
+      /// return the best path found so far.
+      void maxTime (value_type maxTime);
+      /// Get maximal duration of optimization
+      value_type maxTime () const
+      {
+	return maxTime_;
+      }
 
     protected:
       /// Whether to interrupt computation
       /// Set to true at start of optimize method, set to false by method
       /// interrupt.
       bool interrupt_;
-      PathOptimizer (const Problem& problem) : problem_ (problem)
+      PathOptimizer (const Problem& problem) :
+	interrupt_ (false), problem_ (problem),
+	maxTime_ (std::numeric_limits <value_type>::infinity ()), start_ ()
 	{
 	}
 
       PathPtr_t steer (ConfigurationIn_t q1, ConfigurationIn_t q2) const;
 
+      /// Whether optimization should stop
+      ///
+      /// Optimization stops when interrupted or when the maximal duration
+      /// is exceeded.
+      bool stop () const;
+
     private:
       const Problem& problem_;
+      value_type maxTime_;
+      /// Time at which the maximal duration was set
+      boost::posix_time::ptime start_;
     }; // class PathOptimizer;
     /// }
   } // namespace core
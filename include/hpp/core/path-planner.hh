@@ -50,6 +50,28 @@ namespace hpp {
       /// Users can implement themselves the loop to avoid being trapped
       /// in an infinite loop when no solution is found.
       virtual PathVectorPtr_t solve ();
+      /// Solve within a time and an iteration budget
+      ///
+      /// \param maxTime maximal duration in seconds of planning and
+      ///        post-processing,
+      /// \param maxIterations maximal number of calls to oneStep.
+      /// Same as solve () except that oneStep is not called once either
+      /// budget is exhausted. Planners that improve the solution over time
+      /// (see anytime) keep iterating until a budget is exhausted.
+      /// The remaining time is passed to finishSolve.
+      /// \throw std::runtime_error if no path is found within the budget.
+      ///        The message contains the number of iterations and the
+      ///        size of the roadmap.
+      virtual PathVectorPtr_t solve (value_type maxTime,
+				     std::size_t maxIterations);
+      /// Whether the path in the roadmap improves with more iterations
+      ///
+      /// If true, solve with a finite budget keeps calling oneStep after a
+      /// path is found.
+      virtual bool anytime () const
+      {
+	return false;
+      }
       /// Try to make direct connection between init and goal
       /// configurations, in order to avoid a random shoot.
       virtual void tryDirectPath();
@@ -57,7 +79,16 @@ namespace hpp {
       virtual void oneStep () = 0;
       /// Post processing of the resulting path
       virtual PathVectorPtr_t finishSolve (const PathVectorPtr_t& path);
+      /// Post processing of the resulting path within a time budget
+      ///
+      /// \param maxTime maximal duration in seconds.
+      /// Call finishSolve (path) by default.
+      virtual PathVectorPtr_t finishSolve (const PathVectorPtr_t& path,
+					   value_type maxTime);
       /// Interrupt path planning
+      ///
+      /// solve throws if no path has been found yet, and returns the path
+      /// found so far otherwise.
       void interrupt ();
       /// Find a path in the roadmap and transform it in trajectory
       PathVectorPtr_t computePath () const;
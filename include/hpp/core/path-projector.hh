@@ -61,9 +61,16 @@ namespace hpp {
 
         value_type d (ConfigurationIn_t q1, ConfigurationIn_t q2) const;
 	PathPtr_t steer (ConfigurationIn_t q1, ConfigurationIn_t q2) const;
+	/// Layout of the configurations of a robot for the paths built by the
+	/// projector
+	///
+	/// The layout of the distance is shared if the distance is a
+	/// WeighedDistance of the robot, a new layout is created otherwise.
+	ConfigurationLayoutPtr_t layout (const DevicePtr_t& robot) const;
       private:
         DistancePtr_t distance_;
 	SteeringMethodPtr_t steeringMethod_;
+	WeighedDistancePtr_t weighedDistance_;
     };
   } // namespace core
 } // namespace hpp
@@ -43,6 +43,14 @@ namespace hpp {
       virtual void oneStep ();
       /// Optimize planned path
       virtual PathVectorPtr_t finishSolve (const PathVectorPtr_t& path);
+      /// Optimize planned path within a time budget
+      ///
+      /// The remaining time is divided equally among the optimizers that
+      /// have not run yet.
+      virtual PathVectorPtr_t finishSolve (const PathVectorPtr_t& path,
+					   value_type maxTime);
+      /// Whether the internal path planner is anytime
+      virtual bool anytime () const;
       void addPathOptimizer (const PathOptimizerPtr_t& optimizer);
     protected:
       PlanAndOptimize (const PathPlannerPtr_t& pathPlanner);
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_PRM_STAR_PLANNER_HH
+# define HPP_CORE_PRM_STAR_PLANNER_HH
+
+# include <hpp/core/path-planner.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup path_planning
+    /// \{
+
+    /// Asymptotically optimal PRM (k-nearest PRM*)
+    ///
+    /// Each new configuration is connected to its k nearest nodes in the
+    /// roadmap, whatever their connected component, with
+    /// \f$k = \lceil k_{PRM}\log n\rceil\f$, \f$n\f$ being the number of
+    /// nodes and \f$k_{PRM} = e (1 + 1/d)\f$, \f$d\f$ being the number of
+    /// degrees of freedom of the robot.
+    ///
+    /// The shortest path in the roadmap converges toward an optimal path
+    /// as nodes are added. Since the roadmap keeps all the valid edges,
+    /// the shortest path may change homotopy class, unlike the result of
+    /// a path optimizer.
+    ///
+    /// solve () returns the first path found. solve with a budget keeps
+    /// improving the solution until the budget is exhausted. bestCost and
+    /// bestPath give the best solution found so far.
+    class HPP_CORE_DLLAPI PrmStarPlanner : public PathPlanner
+    {
+    public:
+      /// Return shared pointer to new object.
+      static PrmStarPlannerPtr_t createWithRoadmap
+	(const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Return shared pointer to new object.
+      static PrmStarPlannerPtr_t create (const Problem& problem);
+      /// Initialize the problem resolution
+      ///
+      /// The best path of a previous resolution is discarded.
+      virtual void startSolve ();
+      /// Add a node to the roadmap and connect it to its nearest nodes
+      ///
+      /// The best path is updated if the roadmap contains a shorter path
+      /// between the initial node and a goal node.
+      virtual void oneStep ();
+      /// Return true: the roadmap path improves with more iterations.
+      virtual bool anytime () const
+      {
+	return true;
+      }
+      /// Set configuration shooter.
+      void configurationShooter (const ConfigurationShooterPtr_t& shooter);
+      /// Length of the shortest path found so far
+      ///
+      /// Infinity if no path has been found yet.
+      value_type bestCost () const
+      {
+	return bestCost_;
+      }
+      /// Shortest path found so far, empty pointer if none.
+      const PathVectorPtr_t& bestPath () const
+      {
+	return bestPath_;
+      }
+      /// Number of nearest nodes a new node is connected to
+      /// \param n number of nodes in the roadmap.
+      std::size_t numberOfNeighbors (std::size_t n) const;
+    protected:
+      /// Constructor
+      PrmStarPlanner (const Problem& problem, const RoadmapPtr_t& roadmap);
+      /// Constructor with roadmap
+      PrmStarPlanner (const Problem& problem);
+      /// Store weak pointer to itself
+      void init (const PrmStarPlannerWkPtr_t& weak);
+    private:
+      /// Validate the path between two nodes and insert it in the roadmap
+      /// \return whether an edge has been inserted.
+      bool connect (const NodePtr_t& n1, const NodePtr_t& n2);
+      ConfigurationShooterPtr_t configurationShooter_;
+      /// Constant k_PRM of the number of neighbors
+      value_type kPrm_;
+      value_type bestCost_;
+      PathVectorPtr_t bestPath_;
+      PrmStarPlannerWkPtr_t weakPtr_;
+    }; // class PrmStarPlanner
+    /// \}
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_PRM_STAR_PLANNER_HH
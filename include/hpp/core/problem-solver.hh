@@ -23,6 +23,7 @@
 
 # include <hpp/model/fwd.hh>
 # include <boost/function.hpp>
+# include <boost/thread/mutex.hpp>
 # include <hpp/core/deprecated.hh>
 # include <hpp/core/problem.hh>
 # include <hpp/core/fwd.hh>
@@ -52,8 +53,13 @@ namespace hpp {
 	PathProjectorBuilder_t;
       typedef boost::function <ConfigurationShooterPtr_t (const DevicePtr_t&) >
 	ConfigurationShooterBuilder_t;
+      typedef boost::function <NearestNeighborPtr_t (const DevicePtr_t&,
+						     const DistancePtr_t&) >
+	NearestNeighborBuilder_t;
 
       typedef std::vector <PathOptimizerPtr_t> PathOptimizers_t;
+      typedef std::vector <PathPlannerPtr_t> PathPlanners_t;
+      typedef std::vector <std::string> PathPlannerTypes_t;
       typedef std::vector <std::string> PathOptimizerTypes_t;
 
       /// Create instance and return pointer
@@ -102,6 +108,20 @@ namespace hpp {
       {
 	configurationShooterFactory_ [type] = builder;
       }
+      /// Set nearest neighbor method type
+      ///
+      /// If a roadmap exists, the nodes it contains are inserted in the new
+      /// nearest neighbor object.
+      void nearestNeighborType (const std::string& type);
+      /// Add a nearest neighbor method type
+      /// \param type name of the nearest neighbor method type
+      /// \param static method that creates a nearest neighbor object with
+      /// robot and distance as input
+      void addNearestNeighborType (const std::string& type,
+				   const NearestNeighborBuilder_t& builder)
+      {
+	nearestNeighborFactory_ [type] = builder;
+      }
       /// Add a path planner type
       /// \param type name of the new path planner type
       /// \param static method that creates a path planner with a problem
@@ -145,6 +165,14 @@ namespace hpp {
       /// \note each intermediate optimization output is stored in this object.
       void optimizePath (PathVectorPtr_t path);
 
+      /// Optimize path within a time budget
+      ///
+      /// \param path path to optimize,
+      /// \param maxTime maximal duration in seconds.
+      /// The remaining time is divided equally among the optimizers that
+      /// have not run yet.
+      void optimizePath (PathVectorPtr_t path, value_type maxTime);
+
       /// Set path validation method
       /// \param type name of new path validation method
       /// \param tolerance acceptable penetration for path validation
@@ -163,6 +191,23 @@ namespace hpp {
 	pathValidationFactory_ [type] = builder;
       }
 
+      /// Set the number of threads validating paths in path planners
+      ///
+      /// If greater than 1, DiffusingPlanner and VisibilityPrmPlanner
+      /// validate paths in parallel on as many validation contexts of the
+      /// problem (Problem::pathValidations). Other path planners and the
+      /// planners of solvePortfolio validate paths sequentially. Default is
+      /// 1.
+      void numberOfThreads (std::size_t number)
+      {
+	numberOfThreads_ = number;
+      }
+      /// Get the number of threads validating paths in path planners
+      std::size_t numberOfThreads () const
+      {
+	return numberOfThreads_;
+      }
+
       /// Set path projector method
       /// \param type name of new path validation method
       /// \param step discontinuity tolerance
@@ -398,6 +443,37 @@ namespace hpp {
       /// Set and solve the problem
       virtual void solve ();
 
+      /// Set and solve the problem within a time and an iteration budget
+      ///
+      /// \param maxTime maximal duration in seconds of path planning and
+      ///        path optimization,
+      /// \param maxIterations maximal number of steps of the path planner.
+      /// \sa PathPlanner::solve (value_type, std::size_t)
+      /// \throw std::runtime_error if no path is found within the budget.
+      virtual void solve (value_type maxTime, std::size_t maxIterations);
+
+      /// Solve the problem with several path planners racing in parallel
+      ///
+      /// \param pathPlannerTypes names of the path planners, one thread
+      ///        being started for each of them. A name may be repeated to
+      ///        run several instances of a planner with different random
+      ///        streams.
+      /// \param maxTime, maxIterations budget of each path planner, and
+      ///        maximal duration of path planning and path optimization.
+      ///
+      /// Each planner works on its own problem: a validation context of
+      /// the problem (Problem::validationContexts), a configuration shooter
+      /// drawing from its own random stream (RandomEngine::stream) and a
+      /// new roadmap. The first path found is kept and the other planners
+      /// are interrupted. The path is then optimized as by solve.
+      /// The roadmap of the problem solver is not modified.
+      /// \throw std::runtime_error if no planner finds a path, with the
+      ///        reason of each failure, or if the problem has constraints,
+      ///        which cannot be shared between threads.
+      virtual void solvePortfolio (const PathPlannerTypes_t& pathPlannerTypes,
+				   value_type maxTime,
+				   std::size_t maxIterations);
+
       /// Interrupt path planning and path optimization
       void interrupt ();
 
@@ -520,6 +596,20 @@ namespace hpp {
       /// Map (string , constructor of configuration shooter method)
       typedef std::map <std::string, ConfigurationShooterBuilder_t >
         ConfigurationShooterFactory_t;
+      /// Map (string , constructor of nearest neighbor method)
+      typedef std::map <std::string, NearestNeighborBuilder_t >
+	NearestNeighborFactory_t;
+
+      /// Give one path validation per thread to the path planner if it
+      /// supports parallel validation
+      void parallelValidation (const PathPlannerPtr_t& planner) const;
+
+      /// Create the nearest neighbor method of a roadmap of a problem
+      ///
+      /// Randomized methods draw from a stream of the random engine of the
+      /// problem.
+      NearestNeighborPtr_t createNearestNeighbor (const Problem& problem)
+	const;
 
       /// Shared pointer to initial configuration.
       ConfigurationPtr_t initConf_;
@@ -527,17 +617,27 @@ namespace hpp {
       Configurations_t goalConfigurations_;
       /// Configuration shooter
       std::string configurationShooterType_;
+      /// Nearest neighbor method
+      std::string nearestNeighborType_;
       /// Path optimizer
       PathOptimizerTypes_t pathOptimizerTypes_;
       PathOptimizers_t pathOptimizers_;
+      /// Path planners of solvePortfolio while it runs
+      PathPlanners_t portfolio_;
+      /// Protect portfolio_ against concurrent calls to interrupt
+      boost::mutex portfolioMutex_;
       /// Path validation method
       std::string pathValidationType_;
       /// Tolerance of path validation
       value_type pathValidationTolerance_;
+      /// Number of threads validating paths in path planners
+      std::size_t numberOfThreads_;
       /// Path planner factory
       PathPlannerFactory_t pathPlannerFactory_;
       /// Configuration shooter factory
       ConfigurationShooterFactory_t configurationShooterFactory_;
+      /// Nearest neighbor factory
+      NearestNeighborFactory_t nearestNeighborFactory_;
       /// Path optimizer factory
       PathOptimizerFactory_t pathOptimizerFactory_;
       /// Path validation factory
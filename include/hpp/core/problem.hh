@@ -24,6 +24,7 @@
 # include <hpp/util/pointer.hh>
 
 # include <hpp/core/steering-method.hh>
+# include <hpp/core/validation-context.hh>
 
 namespace hpp {
   namespace core {
@@ -148,6 +149,59 @@ namespace hpp {
       }
       /// \}
 
+      /// \name Validation contexts
+      /// \{
+      /// Set the method building the path validation of validation contexts
+      ///
+      /// \param builder function building a path validation method for a
+      ///        copy of the robot,
+      /// \param tolerance tolerance passed to the builder.
+      /// The builder should create the same kind of path validation as
+      /// pathValidation (). Existing contexts are discarded.
+      void pathValidationBuilder
+	(const ValidationContext::PathValidationBuilder_t& builder,
+	 const value_type& tolerance);
+
+      /// Get validation contexts for concurrent validation
+      ///
+      /// \param n number of contexts.
+      /// \return n contexts, each with its own copy of the robot and the
+      ///         obstacles of the problem.
+      /// The contexts are created the first time they are requested and are
+      /// reused by following calls. Each of them should be used by at most
+      /// one thread at a time. This method itself should not be called
+      /// concurrently.
+      /// \note Contexts validate configurations with respect to collisions
+      ///       and joint bounds only. Configuration validation methods
+      ///       added to configValidations () are not replicated, since they
+      ///       are built on the robot of the problem.
+      ValidationContexts_t validationContexts (std::size_t n) const;
+
+      /// Path validation methods of validation contexts
+      ///
+      /// \param n number of path validation methods.
+      /// Convenience method for planners that validate paths in parallel,
+      /// like DiffusingPlanner and VisibilityPrmPlanner.
+      PathValidations_t pathValidations (std::size_t n) const;
+      /// \}
+
+      /// \name Random number generation
+      /// \{
+      /// Set random number generator
+      ///
+      /// The engine is also given to the configuration shooter.
+      void randomEngine (const RandomEnginePtr_t& randomEngine);
+
+      /// Get random number generator
+      ///
+      /// Used by configuration shooters and path optimizers. Threads should
+      /// use RandomEngine::stream.
+      const RandomEnginePtr_t& randomEngine () const
+      {
+	return randomEngine_;
+      }
+      /// \}
+
       /// \name Path projector
       /// \{
       /// Set path projector method
@@ -223,10 +277,19 @@ namespace hpp {
       PathProjectorPtr_t pathProjector_;
       /// List of obstacles
       ObjectVector_t collisionObstacles_;
+      /// Collision pairs removed by removeObstacleFromJoint
+      std::vector <std::pair <JointPtr_t, CollisionObjectPtr_t> >
+	removedPairs_;
       /// Set of constraints applicable to the robot
       ConstraintSetPtr_t constraints_;
       /// Configuration shooter
       ConfigurationShooterPtr_t configurationShooter_;
+      /// Random number generator
+      RandomEnginePtr_t randomEngine_;
+      /// Validation contexts, created on demand
+      mutable ValidationContexts_t validationContexts_;
+      ValidationContext::PathValidationBuilder_t pathValidationBuilder_;
+      value_type pathValidationTolerance_;
     }; // class Problem
     /// \}
   } // namespace core
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_RANDOM_ENGINE_HH
+# define HPP_CORE_RANDOM_ENGINE_HH
+
+# include <boost/random/mersenne_twister.hpp>
+# include <hpp/core/config.hh>
+# include <hpp/core/fwd.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup configuration_sampling
+    /// \{
+
+    /// Seedable pseudo-random number generator
+    ///
+    /// Configuration shooters and path optimizers draw their random
+    /// numbers from the engine of the problem, so that two resolutions with
+    /// the same seed give the same result.
+    ///
+    /// An engine must not be used by several threads at the same time.
+    /// Each thread should use its own stream: streams derived from the same
+    /// seed with different indices are independent and reproducible.
+    class HPP_CORE_DLLAPI RandomEngine
+    {
+    public:
+      typedef boost::random::mt19937 Generator_t;
+
+      /// Default seed
+      static const unsigned int defaultSeed = 5489u;
+
+      /// Return shared pointer to new object.
+      static RandomEnginePtr_t create (unsigned int seed = defaultSeed);
+
+      /// Reset the engine with a new seed
+      void seed (unsigned int seed);
+      /// Seed of the engine
+      unsigned int seed () const
+      {
+	return seed_;
+      }
+
+      /// Independent engine for a thread
+      ///
+      /// \param index index of the stream.
+      /// The seed of the new engine only depends on the seed of this engine
+      /// and on the index, not on the numbers already drawn.
+      RandomEnginePtr_t stream (std::size_t index) const;
+
+      /// Draw a number uniformly in [0,1)
+      value_type uniform ();
+      /// Draw a number uniformly in [lower,upper)
+      value_type uniform (value_type lower, value_type upper)
+      {
+	return lower + (upper - lower) * uniform ();
+      }
+      /// Draw an integer uniformly in {0,...,n-1}
+      /// \param n positive integer.
+      std::size_t uniformInt (std::size_t n);
+
+      /// Underlying generator, to be used with boost::random distributions
+      Generator_t& generator ()
+      {
+	return generator_;
+      }
+
+    protected:
+      RandomEngine (unsigned int seed);
+
+    private:
+      unsigned int seed_;
+      Generator_t generator_;
+    }; // class RandomEngine
+    /// \}
+  } //   namespace core
+} // namespace hpp
+#endif // HPP_CORE_RANDOM_ENGINE_HH
@@ -60,6 +60,33 @@ namespace hpp {
 			     const ConnectedComponentPtr_t& connectedComponent,
 			     value_type& minDistance);
 
+      /// Get nearest node to a configuration in each connected component.
+      /// \param configuration configuration
+      /// \retval nearest map from connected components to their nearest
+      ///         node and the distance to this node.
+      /// The tree is traversed only once for all connected components.
+      void nearestNodes (const ConfigurationPtr_t& configuration,
+			 NearestNodes_t& nearest);
+
+      /// Get the k nearest nodes to a configuration in a connected component.
+      /// \param configuration configuration
+      /// \param connectedComponent the connected component
+      /// \param k maximal number of nodes returned
+      /// \return nodes sorted by increasing distance to configuration.
+      Nodes_t nearestNodes (const ConfigurationPtr_t& configuration,
+			    const ConnectedComponentPtr_t& connectedComponent,
+			    std::size_t k);
+
+      /// Get the nodes of a connected component within a given distance.
+      /// \param configuration configuration
+      /// \param connectedComponent the connected component
+      /// \param maxDistance radius of the ball centered at configuration
+      /// \return nodes sorted by increasing distance to configuration.
+      Nodes_t nodesWithinBall (const ConfigurationPtr_t& configuration,
+			       const ConnectedComponentPtr_t&
+			       connectedComponent,
+			       value_type maxDistance);
+
       /// Add a node and two edges
       /// \param from node from which the edge starts,
       /// \param to configuration to which the edge stops
@@ -79,10 +106,8 @@ namespace hpp {
       /// as goal node. Otherwise create a new node.
       void addGoalNode (const ConfigurationPtr_t& config);
 
-      void resetGoalNodes ()
-      {
-	goalNodes_.clear ();
-      }
+      /// Remove all goal nodes
+      void resetGoalNodes ();
 
       void initNode (const ConfigurationPtr_t& config)
       {
@@ -91,6 +116,10 @@ namespace hpp {
 
       virtual ~Roadmap ();
       /// Check that a path exists between the initial node and one goal node.
+      ///
+      /// Reachability of the goal nodes is maintained incrementally by the
+      /// roadmap, see ConnectedComponent::canReachGoal, so that this check
+      /// takes constant time.
       bool pathExists () const;
       const Nodes_t& nodes () const
       {
@@ -111,10 +140,24 @@ namespace hpp {
       /// Get list of connected component of the roadmap
       const ConnectedComponents_t& connectedComponents () const;
 
+      /// Get configurations of the nodes stored contiguously
+      ///
+      /// Column i is the configuration of the node of index i (see
+      /// Node::index), so that distances to many nodes can be computed
+      /// without following a pointer per node.
+      matrix_t::ConstColsBlockXpr configurations () const
+      {
+	return configurations_.leftCols (nodeCount_);
+      }
+
       /// Get nearestNeighbor object
       NearestNeighborPtr_t nearestNeighbor();
 
-      /// Set new NearestNeighbor (roadmap must be empty)
+      /// Set new NearestNeighbor
+      ///
+      /// Nodes already in the roadmap are inserted in the new object by a
+      /// bulk build, for instance after loading a roadmap. The new object
+      /// reads the configurations of the nodes from the roadmap.
       void nearestNeighbor(NearestNeighborPtr_t nearestNeighbor);
 
       /// \name Distance used for nearest neighbor search
@@ -163,6 +206,9 @@ namespace hpp {
       NodePtr_t addNode (const ConfigurationPtr_t& config,
 			 ConnectedComponentPtr_t connectedComponent);
 
+      /// Give an index to a new node and store its configuration
+      void storeConfiguration (const NodePtr_t& node);
+
       /// Add two edges between two nodes
       /// \param from first node
       /// \param to second node
@@ -183,9 +229,17 @@ namespace hpp {
       void merge (const ConnectedComponentPtr_t& cc1,
 		  ConnectedComponents_t& ccs);
 
+      /// Record that a connected component can reach a goal node, as well
+      /// as the connected components that can reach it.
+      void markCanReachGoal (const ConnectedComponentPtr_t& cc);
+
       const DistancePtr_t distance_;
       ConnectedComponents_t connectedComponents_;
       Nodes_t nodes_;
+      /// Configurations of the nodes, capacity may exceed the number of
+      /// nodes.
+      matrix_t configurations_;
+      std::size_t nodeCount_;
       Edges_t edges_;
       NodePtr_t initNode_;
       Nodes_t goalNodes_;
@@ -72,7 +72,8 @@ namespace hpp {
       {
         value_type length = (*distance_) (q1, q2);
         PathPtr_t path = StraightPath::create (device_.lock (), q1, q2, length,
-					       constraints ());
+					       constraints (),
+					       distance_->layout ());
         return path;
       }
     protected:
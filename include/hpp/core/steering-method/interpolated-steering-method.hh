@@ -74,7 +74,7 @@ namespace hpp {
           {
             value_type length = (*distance_) (q1, q2);
             PathPtr_t path = InterpolatedPath::create (device_.lock (), q1, q2,
-                length, constraints ());
+                length, constraints (), distance_->layout ());
             return path;
           }
 
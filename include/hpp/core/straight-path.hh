@@ -45,6 +45,8 @@ namespace hpp {
       /// \param device Robot corresponding to configurations
       /// \param init, end Start and end configurations of the path
       /// \param length Distance between the configurations.
+      /// \note the layout of the configurations is built for each path,
+      ///       the overload taking a layout avoids it.
       static StraightPathPtr_t create (const DevicePtr_t& device,
 				       ConfigurationIn_t init,
 				       ConfigurationIn_t end,
@@ -61,6 +63,8 @@ namespace hpp {
       /// \param init, end Start and end configurations of the path
       /// \param length Distance between the configurations.
       /// \param constraints the path is subject to
+      /// \note the layout of the configurations is built for each path,
+      ///       the overload taking a layout avoids it.
       static StraightPathPtr_t create (const DevicePtr_t& device,
 				       ConfigurationIn_t init,
 				       ConfigurationIn_t end,
@@ -74,6 +78,27 @@ namespace hpp {
 	return shPtr;
       }
 
+      /// Create instance and return shared pointer
+      /// \param device Robot corresponding to configurations
+      /// \param init, end Start and end configurations of the path
+      /// \param length Distance between the configurations.
+      /// \param constraints the path is subject to
+      /// \param layout layout of the configurations of the robot, shared
+      ///        between the paths of a steering method.
+      static StraightPathPtr_t create (const DevicePtr_t& device,
+				       ConfigurationIn_t init,
+				       ConfigurationIn_t end,
+				       value_type length,
+				       ConstraintSetPtr_t constraints,
+				       const ConfigurationLayoutPtr_t& layout)
+      {
+	StraightPath* ptr = new StraightPath (device, init, end, length,
+					      constraints, layout);
+	StraightPathPtr_t shPtr (ptr);
+	ptr->init (shPtr);
+	return shPtr;
+      }
+
       /// Create copy and return shared pointer
       /// \param path path to copy
       static StraightPathPtr_t createCopy (const StraightPathPtr_t& path)
@@ -176,6 +201,12 @@ namespace hpp {
 		    ConfigurationIn_t end, value_type length,
 		    ConstraintSetPtr_t constraints);
 
+      /// Constructor with constraints and layout
+      StraightPath (const DevicePtr_t& robot, ConfigurationIn_t init,
+		    ConfigurationIn_t end, value_type length,
+		    ConstraintSetPtr_t constraints,
+		    const ConfigurationLayoutPtr_t& layout);
+
       /// Copy constructor
       StraightPath (const StraightPath& path);
 
@@ -200,6 +231,7 @@ namespace hpp {
 
     private:
       DevicePtr_t device_;
+      ConfigurationLayoutPtr_t layout_;
       Configuration_t initial_;
       Configuration_t end_;
       StraightPathWkPtr_t weak_;
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_VALIDATION_CONTEXT_HH
+# define HPP_CORE_VALIDATION_CONTEXT_HH
+
+# include <string>
+# include <utility>
+# include <vector>
+# include <boost/function.hpp>
+# include <hpp/core/config.hh>
+# include <hpp/core/fwd.hh>
+
+namespace hpp {
+  namespace core {
+    /// \addtogroup validation
+    /// \{
+
+    /// Objects needed to validate configurations and paths in a thread
+    ///
+    /// Validation sets the configuration of the robot and moves the
+    /// collision objects of its bodies. A context owns a copy of the robot,
+    /// with its own collision objects, and validation methods built on this
+    /// copy, so that validations in different contexts can run at the same
+    /// time. Obstacles are shared between contexts: they are not modified by
+    /// validation.
+    ///
+    /// A context must be used by one thread at a time. Paths that are
+    /// projected on constraints during validation still use the robot of
+    /// the constraints and cannot be validated concurrently.
+    class HPP_CORE_DLLAPI ValidationContext
+    {
+    public:
+      typedef boost::function < PathValidationPtr_t (const DevicePtr_t&,
+						     const value_type&) >
+	PathValidationBuilder_t;
+
+      /// Create a context on a copy of a robot
+      /// \param robot robot to copy,
+      /// \param pathValidationBuilder function building the path validation
+      ///        method on the copy of the robot,
+      /// \param tolerance tolerance passed to pathValidationBuilder.
+      /// Configurations are validated with respect to collisions and joint
+      /// bounds, as in Problem.
+      static ValidationContextPtr_t create
+	(const DevicePtr_t& robot,
+	 const PathValidationBuilder_t& pathValidationBuilder,
+	 const value_type& tolerance);
+
+      /// Create a context on a new copy of the robot, with the same
+      /// obstacles
+      ValidationContextPtr_t clone () const;
+
+      /// Copy of the robot
+      const DevicePtr_t& robot () const
+      {
+	return robot_;
+      }
+      /// Configuration validation methods on the copy of the robot
+      const ConfigValidationsPtr_t& configValidations () const
+      {
+	return configValidations_;
+      }
+      /// Path validation method on the copy of the robot
+      const PathValidationPtr_t& pathValidation () const
+      {
+	return pathValidation_;
+      }
+
+      /// Add an obstacle to the validation methods
+      void addObstacle (const CollisionObjectPtr_t& object);
+      /// Remove a collision pair between a joint and an obstacle
+      /// \param joint joint of the original robot or of the copy,
+      /// \param obstacle the obstacle to remove.
+      /// The joint of the copy is found by name.
+      void removeObstacleFromJoint (const JointPtr_t& joint,
+				    const CollisionObjectPtr_t& obstacle);
+
+    protected:
+      ValidationContext (const DevicePtr_t& robot,
+			 const PathValidationBuilder_t& pathValidationBuilder,
+			 const value_type& tolerance);
+
+    private:
+      void removeObstacleFromJoint (const std::string& jointName,
+				    const CollisionObjectPtr_t& obstacle);
+
+      /// Robot from which the copies are made
+      DevicePtr_t original_;
+      DevicePtr_t robot_;
+      PathValidationBuilder_t pathValidationBuilder_;
+      value_type tolerance_;
+      ConfigValidationsPtr_t configValidations_;
+      PathValidationPtr_t pathValidation_;
+      ObjectVector_t obstacles_;
+      /// Removed collision pairs, joints being stored by name
+      std::vector <std::pair <std::string, CollisionObjectPtr_t> >
+	removedPairs_;
+    }; // class ValidationContext
+    /// \}
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_VALIDATION_CONTEXT_HH
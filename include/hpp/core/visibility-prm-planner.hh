@@ -19,6 +19,8 @@
 #ifndef HPP_CORE_VISIBILITY_PRM_PLANNER_HH
 # define HPP_CORE_VISIBILITY_PRM_PLANNER_HH
 
+# include <string>
+# include <vector>
 # include <boost/tuple/tuple.hpp>
 # include <hpp/core/path-planner.hh>
 
@@ -42,6 +44,18 @@ namespace hpp {
       virtual void oneStep ();
       /// Set configuration shooter.
       void configurationShooter (const ConfigurationShooterPtr_t& shooter);
+      /// Set path validation methods used to test visibility in parallel
+      ///
+      /// The connected components are shared among one thread per path
+      /// validation method. The threads are created here and kept alive
+      /// between steps. Since validation modifies the configuration of
+      /// the robot, each method should work on its own copy of the robot, as
+      /// the methods returned by Problem::pathValidations.
+      ///
+      /// Visibility is tested sequentially by the path validation of the
+      /// problem if the vector is empty (default) or if the steering method
+      /// has a ConfigProjector, whose state is shared by all paths.
+      void pathValidations (const PathValidations_t& pathValidations);
     protected:
       /// Constructor
       VisibilityPrmPlanner (const Problem& problem, 
@@ -54,15 +68,43 @@ namespace hpp {
       typedef boost::tuple <NodePtr_t, ConfigurationPtr_t, PathPtr_t>
 	DelayedEdge_t;
       typedef std::vector <DelayedEdge_t> DelayedEdges_t;
+      /// Guards of a connected component and result of the visibility test
+      struct VisibilityTask
+      {
+	/// Guards sorted by increasing distance to the configuration
+	std::vector <std::pair <value_type, NodePtr_t> > guards;
+	/// First guard that sees the configuration, NULL if none
+	NodePtr_t guard;
+	/// Path from the configuration to the guard
+	PathPtr_t path;
+	/// Message of the exception thrown by the validation, if any
+	std::string error;
+      }; // struct VisibilityTask
+      typedef std::vector <VisibilityTask> VisibilityTasks_t;
       ConfigurationShooterPtr_t configurationShooter_;
+      PathValidations_t pathValidations_;
+      /// One worker per path validation method
+      ThreadPoolPtr_t threadPool_;
       VisibilityPrmPlannerWkPtr_t weakPtr_;
       DelayedEdges_t delayedEdges_;
-      std::map <NodePtr_t, bool> nodeStatus_; // true for guard node
+      /// Guard status of the nodes indexed by Node::index
+      std::vector <bool> guards_;
 
-      /// Return true if the configuration is visible from the given 
-      /// connected component.
-      bool visibleFromCC (const ConfigurationPtr_t q, 
-			  const ConnectedComponentPtr_t cc);
+      /// Whether a node is a guard node
+      bool isGuard (const NodePtr_t& node) const;
+      /// Set whether a node is a guard node
+      void isGuard (const NodePtr_t& node, bool guard);
+
+      /// Find the first guard of the task that sees the configuration
+      ///
+      /// Guards are tried by increasing distance, the search stops at the
+      /// first visible guard.
+      void visibleFromCC (const ConfigurationPtr_t q, VisibilityTask& task,
+			  const PathValidationPtr_t& pathValidation) const;
+      /// Process the tasks of rank thread modulo the number of threads
+      void visibleFromCCs (const ConfigurationPtr_t q,
+			   VisibilityTasks_t* tasks, std::size_t thread,
+			   std::size_t threads) const;
       
       /// Apply the problem constraints on a given configuration qTo by 
       /// projecting it on the tangent space of qFrom.
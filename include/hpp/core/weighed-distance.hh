@@ -39,6 +39,22 @@ namespace hpp {
       static WeighedDistancePtr_t createCopy
 	(const WeighedDistancePtr_t& distance);
       virtual DistancePtr_t clone () const;
+      /// Distances between a configuration and a set of configurations
+      ///
+      /// The contribution of vector space joints is computed for all the
+      /// configurations at once. Only rotation joints need a call per
+      /// configuration.
+      virtual void compute (ConfigurationIn_t q,
+			    const matrixIn_t& configurations,
+			    vectorOut_t distances) const;
+      /// Lower bound of the distance between two configurations
+      ///
+      /// Sum of the weighed squared differences of vector space joint
+      /// coordinates and of the squared chords between the (cos, sin) pairs
+      /// of unbounded rotations and between SO3 quaternions. No virtual
+      /// call is made per joint.
+      virtual value_type lowerBound (ConfigurationIn_t q1,
+				     ConfigurationIn_t q2) const;
       /// Get weight of joint at given rank
       /// \param rank rank of the joint in robot joint vector
       value_type getWeight( std::size_t rank ) const;
@@ -56,6 +72,12 @@ namespace hpp {
       {
 	return robot_;
       }
+
+      /// Get layout of the configurations of the robot
+      const ConfigurationLayoutPtr_t& layout () const
+      {
+	return layout_;
+      }
     protected:
       WeighedDistance (const DevicePtr_t& robot);
       WeighedDistance (const DevicePtr_t& robot,
@@ -66,8 +88,21 @@ namespace hpp {
       virtual value_type impl_distance (ConfigurationIn_t q1,
 				    ConfigurationIn_t q2) const;
     private:
+      /// Compute the per coordinate weights from the joint weights
+      void computeCoordinateWeights ();
+
       DevicePtr_t robot_;
+      ConfigurationLayoutPtr_t layout_;
       std::vector <value_type> weights_;
+      /// Squared weights of the coordinates of vector space joints, 0 for
+      /// the coordinates of rotations.
+      vector_t linearWeights_;
+      /// Other joints with degrees of freedom and their squared weight
+      std::vector <std::pair <JointPtr_t, value_type> > rotationJoints_;
+      /// Rank in configuration and squared weight of SO3 joints
+      std::vector <std::pair <size_type, value_type> > so3Weights_;
+      /// Rank in configuration and squared weight of unbounded rotations
+      std::vector <std::pair <size_type, value_type> > so2Weights_;
       WeighedDistanceWkPtr_t weak_;
     }; // class WeighedDistance
     /// \}
@@ -19,31 +19,59 @@
 #ifndef HPP_CORE_ASTAR_HH
 # define HPP_CORE_ASTAR_HH
 
-# include <limits>
+# include <vector>
 # include <hpp/core/fwd.hh>
 # include <hpp/core/distance.hh>
 # include <hpp/core/edge.hh>
 # include <hpp/core/node.hh>
 # include <hpp/core/path-vector.hh>
+# include <hpp/core/roadmap.hh>
+# include "nearest-neighbor/vp-tree.hh"
 
 namespace hpp {
   namespace core {
+    // A* search in a roadmap
+    //
+    // Bookkeeping is stored in arrays indexed by Node::index and the open
+    // set is an indexed binary heap, so that a search costs
+    // O(e log n) for a roadmap of n nodes and e edges.
+    //
+    // The heuristic is the distance to the nearest goal node, found in a
+    // vantage point tree built over the goal nodes at each search. The
+    // search is exact, so the heuristic is the same as a scan of all the
+    // goal nodes and remains admissible.
     class Astar
     {
-      typedef std::list < NodePtr_t > Nodes_t;
       typedef std::list <EdgePtr_t> Edges_t;
-      typedef std::map <NodePtr_t, EdgePtr_t> Parent_t;
-      Nodes_t closed_;
-      Nodes_t open_;
-      std::map <NodePtr_t, value_type> costFromStart_;
-      std::map <NodePtr_t, value_type> estimatedCostToGoal_;
-      Parent_t parent_;
+      // state of a node during the search
+      enum State {
+	UNVISITED,
+	OPEN,
+	CLOSED
+      };
       RoadmapPtr_t roadmap_;
       DistancePtr_t distance_;
+      // per node bookkeeping, indexed by Node::index ()
+      std::vector <NodePtr_t> nodes_;
+      std::vector <State> state_;
+      std::vector <value_type> costFromStart_;
+      std::vector <value_type> estimatedCostToGoal_;
+      // heuristic, computed once per node
+      std::vector <value_type> heuristic_;
+      std::vector <EdgePtr_t> parent_;
+      // order in which the nodes entered the open set, breaks ties between
+      // equal estimated costs in favor of the oldest node.
+      std::vector <std::size_t> order_;
+      // open set: binary heap of node indices and position of each node
+      // in the heap.
+      std::vector <std::size_t> heap_;
+      std::vector <std::size_t> position_;
+      // goal nodes of the roadmap
+      nearestNeighbor::VPTree goals_;
 
     public:
       Astar (const RoadmapPtr_t& roadmap, const DistancePtr_t distance) :
-	roadmap_ (roadmap), distance_ (distance)
+	roadmap_ (roadmap), distance_ (distance), goals_ (distance, 16)
       {
       }
 
@@ -52,14 +80,9 @@ namespace hpp {
 	NodePtr_t node = findPath ();
 	Edges_t edges;
 
-	while (node) {
-	  Parent_t::const_iterator itEdge = parent_.find (node);
-	  if (itEdge != parent_.end ()) {
-	    EdgePtr_t edge = itEdge->second;
-	    edges.push_front (edge);
-	    node = edge->from ();
-	  }
-	  else node = NodePtr_t (0x0);
+	while (EdgePtr_t edge = parent_ [node->index ()]) {
+	  edges.push_front (edge);
+	  node = edge->from ();
 	}
 	PathVectorPtr_t pathVector;
 	for (Edges_t::const_iterator itEdge = edges.begin ();
@@ -74,81 +97,128 @@ namespace hpp {
       }
 
     private:
-      struct SortFunctor {
-	std::map <NodePtr_t, value_type>& cost_;
-	SortFunctor (std::map <NodePtr_t, value_type>& cost) :
-	  cost_ (cost) {}
-	bool operator () (const NodePtr_t& n1, const NodePtr_t& n2)
-	{
-	  return cost_ [n1] < cost_ [n2];
+      // Whether node of index i1 should be expanded before node of index i2
+      bool before (std::size_t i1, std::size_t i2) const
+      {
+	if (estimatedCostToGoal_ [i1] != estimatedCostToGoal_ [i2]) {
+	  return estimatedCostToGoal_ [i1] < estimatedCostToGoal_ [i2];
+	}
+	return order_ [i1] < order_ [i2];
+      }
+
+      void moveUp (std::size_t pos)
+      {
+	std::size_t i = heap_ [pos];
+	while (pos > 0) {
+	  std::size_t parentPos = (pos - 1) / 2;
+	  if (!before (i, heap_ [parentPos])) break;
+	  heap_ [pos] = heap_ [parentPos];
+	  position_ [heap_ [pos]] = pos;
+	  pos = parentPos;
 	}
-      }; // struc SortFunctor
+	heap_ [pos] = i;
+	position_ [i] = pos;
+      }
 
-      bool isGoal (const NodePtr_t node)
+      void moveDown (std::size_t pos)
       {
-	for (Nodes_t::const_iterator itGoal = roadmap_->goalNodes ().begin ();
-	     itGoal != roadmap_->goalNodes ().end (); ++itGoal) {
-	  if (*itGoal == node) {
-	    return true;
+	std::size_t i = heap_ [pos];
+	const std::size_t size = heap_.size ();
+	while (2 * pos + 1 < size) {
+	  std::size_t child = 2 * pos + 1;
+	  if (child + 1 < size && before (heap_ [child + 1], heap_ [child])) {
+	    ++child;
 	  }
+	  if (!before (heap_ [child], i)) break;
+	  heap_ [pos] = heap_ [child];
+	  position_ [heap_ [pos]] = pos;
+	  pos = child;
 	}
-	return false;
+	heap_ [pos] = i;
+	position_ [i] = pos;
+      }
+
+      std::size_t popOpen ()
+      {
+	std::size_t top = heap_.front ();
+	heap_.front () = heap_.back ();
+	heap_.pop_back ();
+	if (!heap_.empty ()) moveDown (0);
+	return top;
+      }
+
+      void pushOpen (std::size_t i)
+      {
+	heap_.push_back (i);
+	moveUp (heap_.size () - 1);
+      }
+
+      // Allocate bookkeeping for the nodes of the roadmap
+      void reset ()
+      {
+	const std::size_t n = roadmap_->nodes ().size ();
+	nodes_.assign (n, NodePtr_t (0x0));
+	for (Nodes_t::const_iterator itNode = roadmap_->nodes ().begin ();
+	     itNode != roadmap_->nodes ().end (); ++itNode) {
+	  assert ((*itNode)->index () < n);
+	  nodes_ [(*itNode)->index ()] = *itNode;
+	}
+	state_.assign (n, UNVISITED);
+	goals_.build (roadmap_->goalNodes ());
+	costFromStart_.assign (n, 0);
+	estimatedCostToGoal_.assign (n, 0);
+	heuristic_.assign (n, 0);
+	parent_.assign (n, EdgePtr_t (0x0));
+	order_.assign (n, 0);
+	position_.assign (n, 0);
+	heap_.clear ();
+	heap_.reserve (n);
       }
 
       NodePtr_t findPath ()
       {
-	closed_.clear ();
-	open_.clear ();
-	parent_.clear ();
-	estimatedCostToGoal_.clear ();
-	costFromStart_.clear ();
-
-	open_.push_back (roadmap_->initNode ());
-	while (!open_.empty ()) {
-	  open_.sort (SortFunctor (estimatedCostToGoal_));
-	  Nodes_t::iterator itv = open_.begin ();
-	  NodePtr_t current (*itv);
-	  if (isGoal (current)) {
-	    return current;
+	reset ();
+	std::size_t count = 0;
+	std::size_t init = roadmap_->initNode ()->index ();
+	state_ [init] = OPEN;
+	order_ [init] = count++;
+	pushOpen (init);
+	while (!heap_.empty ()) {
+	  std::size_t current = popOpen ();
+	  if (nodes_ [current]->isGoal ()) {
+	    return nodes_ [current];
 	  }
-	  open_.erase (itv);
-	  closed_.push_back (current);
-	  for (Edges_t::const_iterator itEdge = current->outEdges ().begin ();
-	       itEdge != current->outEdges ().end (); ++itEdge) {
-	    value_type transitionCost = edgeCost (*itEdge);
-	    NodePtr_t child ((*itEdge)->to ());
-	    if (std::find (closed_.begin (), closed_.end (), child) ==
-		closed_.end ()) {
-	      // node is not in closed set
-	      value_type tmpCost = costFromStart_ [current] + transitionCost;
-	      bool childNotInOpenSet = (std::find (open_.begin (),
-						   open_.end (),
-						   child) == open_.end ());
-	      if ((childNotInOpenSet) || (tmpCost < costFromStart_ [child])) {
-		parent_ [child] = *itEdge;
-		costFromStart_ [child] = tmpCost;
-		estimatedCostToGoal_ [child] = costFromStart_ [child] +
-		  heuristic (child);
-		if (childNotInOpenSet) open_.push_back (child);
-	      }
+	  state_ [current] = CLOSED;
+	  const NodePtr_t& node (nodes_ [current]);
+	  for (Edges_t::const_iterator itEdge = node->outEdges ().begin ();
+	       itEdge != node->outEdges ().end (); ++itEdge) {
+	    std::size_t child ((*itEdge)->to ()->index ());
+	    if (state_ [child] == CLOSED) continue;
+	    value_type tmpCost = costFromStart_ [current] + edgeCost (*itEdge);
+	    if (state_ [child] == UNVISITED) {
+	      parent_ [child] = *itEdge;
+	      costFromStart_ [child] = tmpCost;
+	      heuristic_ [child] = heuristic (nodes_ [child]);
+	      estimatedCostToGoal_ [child] = tmpCost + heuristic_ [child];
+	      state_ [child] = OPEN;
+	      order_ [child] = count++;
+	      pushOpen (child);
+	    } else if (tmpCost < costFromStart_ [child]) {
+	      // The estimated cost decreases, the node moves up in the heap.
+	      parent_ [child] = *itEdge;
+	      costFromStart_ [child] = tmpCost;
+	      estimatedCostToGoal_ [child] = tmpCost + heuristic_ [child];
+	      moveUp (position_ [child]);
 	    }
 	  }
 	}
 	throw std::runtime_error ("A* failed to find a solution to the goal.");
       }
 
-      value_type heuristic (const NodePtr_t node) const
+      value_type heuristic (const NodePtr_t node)
       {
-	const ConfigurationPtr_t config = node->configuration ();
-	value_type res = std::numeric_limits <value_type>::infinity ();
-	for (Nodes_t::const_iterator itGoal = roadmap_->goalNodes ().begin ();
-	     itGoal != roadmap_->goalNodes ().end (); ++itGoal) {
-	  ConfigurationPtr_t goal = (*itGoal)->configuration ();
-	  value_type dist = (*distance_) (*config, *goal);
-	  if (dist < res) {
-	    res = dist;
-	  }
-	}
+	value_type res;
+	goals_.search (node->configuration (), res);
 	return res;
       }
 
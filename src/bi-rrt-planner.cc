@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <limits>
+#include <hpp/util/debug.hh>
+#include <hpp/model/device.hh>
+#include <hpp/core/bi-rrt-planner.hh>
+#include <hpp/core/config-projector.hh>
+#include <hpp/core/configuration-shooter.hh>
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/path.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/problem.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/steering-method.hh>
+
+namespace hpp {
+  namespace core {
+    BiRRTPlannerPtr_t BiRRTPlanner::createWithRoadmap
+    (const Problem& problem, const RoadmapPtr_t& roadmap)
+    {
+      BiRRTPlanner* ptr = new BiRRTPlanner (problem, roadmap);
+      BiRRTPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    BiRRTPlannerPtr_t BiRRTPlanner::create (const Problem& problem)
+    {
+      BiRRTPlanner* ptr = new BiRRTPlanner (problem);
+      BiRRTPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    BiRRTPlanner::BiRRTPlanner (const Problem& problem) :
+      PathPlanner (problem),
+      configurationShooter_ (problem.configurationShooter ()),
+      qProj_ (problem.robot ()->configSize ()), extendStartTree_ (true)
+    {
+    }
+
+    BiRRTPlanner::BiRRTPlanner (const Problem& problem,
+				const RoadmapPtr_t& roadmap) :
+      PathPlanner (problem, roadmap),
+      configurationShooter_ (problem.configurationShooter ()),
+      qProj_ (problem.robot ()->configSize ()), extendStartTree_ (true)
+    {
+    }
+
+    void BiRRTPlanner::init (const BiRRTPlannerWkPtr_t& weak)
+    {
+      PathPlanner::init (weak);
+      weakPtr_ = weak;
+    }
+
+    void BiRRTPlanner::startSolve ()
+    {
+      PathPlanner::startSolve ();
+      extendStartTree_ = true;
+    }
+
+    PathPtr_t BiRRTPlanner::extend (const NodePtr_t& near,
+				    const ConfigurationPtr_t& target)
+    {
+      const SteeringMethodPtr_t& sm (problem ().steeringMethod ());
+      const ConstraintSetPtr_t& constraints (sm->constraints ());
+      PathPtr_t path;
+      if (constraints) {
+	ConfigProjectorPtr_t configProjector (constraints->configProjector ());
+	if (configProjector) {
+	  configProjector->projectOnKernel (*(near->configuration ()), *target,
+					    qProj_);
+	} else {
+	  qProj_ = *target;
+	}
+	if (!constraints->apply (qProj_)) return PathPtr_t ();
+	path = (*sm) (*(near->configuration ()), qProj_);
+      } else {
+	path = (*sm) (*(near->configuration ()), *target);
+      }
+      if (!path) return PathPtr_t ();
+      PathPtr_t validPath;
+      PathValidationReportPtr_t report;
+      problem ().pathValidation ()->validate (path, false, validPath, report);
+      if (validPath->timeRange ().second == path->timeRange ().first) {
+	return PathPtr_t ();
+      }
+      return validPath;
+    }
+
+    NodePtr_t BiRRTPlanner::nearestNode (const ConfigurationPtr_t&
+					 configuration, bool startTree,
+					 value_type& distance)
+    {
+      const RoadmapPtr_t& r (roadmap ());
+      if (startTree) {
+	return r->nearestNode (configuration,
+			       r->initNode ()->connectedComponent (),
+			       distance);
+      }
+      // Several goal nodes may belong to different trees, the nearest node
+      // of all of them is returned.
+      NodePtr_t result = 0x0;
+      distance = std::numeric_limits <value_type>::infinity ();
+      ConnectedComponents_t visited;
+      for (Nodes_t::const_iterator itGoal = r->goalNodes ().begin ();
+	   itGoal != r->goalNodes ().end (); ++itGoal) {
+	ConnectedComponentPtr_t cc ((*itGoal)->connectedComponent ());
+	if (visited.count (cc)) continue;
+	visited.insert (cc);
+	value_type d;
+	NodePtr_t near = r->nearestNode (configuration, cc, d);
+	if (d < distance) {
+	  distance = d;
+	  result = near;
+	}
+      }
+      return result;
+    }
+
+    /// This method performs one step of RRT-Connect as follows
+    ///  1. a random configuration "q_rand" is shot,
+    ///  2. the nearest node "q_near" of the tree to extend is extended
+    ///     toward "q_rand" (method extend), the end of the valid part of the
+    ///     path, "q_new", is added to the tree,
+    ///  3. the nearest node of the other tree is connected toward "q_new":
+    ///     if the path is valid the trees are connected, otherwise the end
+    ///     of the valid part of the path is added to the other tree.
+    ///  4. the trees swap roles for the next step.
+    void BiRRTPlanner::oneStep ()
+    {
+      const bool startTree = extendStartTree_;
+      extendStartTree_ = !extendStartTree_;
+      ConfigurationPtr_t q_rand = configurationShooter_->shoot ();
+      value_type distance;
+      NodePtr_t near = nearestNode (q_rand, startTree, distance);
+      if (!near) return;
+      PathPtr_t validPath = extend (near, q_rand);
+      if (!validPath) return;
+      ConfigurationPtr_t q_new (new Configuration_t (validPath->end ()));
+      NodePtr_t newNode = roadmap ()->addNodeAndEdges (near, q_new,
+						       validPath);
+
+      // Connect the other tree toward q_new up to the first collision
+      near = nearestNode (q_new, !startTree, distance);
+      if (!near) return;
+      if (near->connectedComponent () == newNode->connectedComponent ()) {
+	return;
+      }
+      const SteeringMethodPtr_t& sm (problem ().steeringMethod ());
+      PathPtr_t path = (*sm) (*(near->configuration ()), *q_new);
+      if (!path) return;
+      PathValidationReportPtr_t report;
+      bool pathValid = problem ().pathValidation ()->validate
+	(path, false, validPath, report);
+      if (pathValid) {
+	hppDout (info, "trees connected");
+	roadmap ()->addEdge (near, newNode, path);
+	interval_t timeRange = path->timeRange ();
+	roadmap ()->addEdge (newNode, near, path->extract
+			     (interval_t (timeRange.second,
+					  timeRange.first)));
+      } else if (validPath->timeRange ().second !=
+		 path->timeRange ().first) {
+	ConfigurationPtr_t q_connect (new Configuration_t
+				      (validPath->end ()));
+	roadmap ()->addNodeAndEdges (near, q_connect, validPath);
+      }
+    }
+
+    void BiRRTPlanner::configurationShooter
+    (const ConfigurationShooterPtr_t& shooter)
+    {
+      configurationShooter_ = shooter;
+    }
+  } // namespace core
+} // namespace hpp
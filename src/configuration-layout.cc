@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <hpp/model/device.hh>
+#include <hpp/model/joint.hh>
+#include <hpp/model/joint-configuration.hh>
+#include <hpp/core/configuration-layout.hh>
+#include <hpp/core/random-engine.hh>
+
+namespace hpp {
+  namespace core {
+    ConfigurationLayoutPtr_t ConfigurationLayout::create
+    (const DevicePtr_t& robot)
+    {
+      return ConfigurationLayoutPtr_t (new ConfigurationLayout (robot));
+    }
+
+    ConfigurationLayout::ConfigurationLayout (const DevicePtr_t& robot) :
+      configSize_ (robot->configSize ()), segments_ (), rotations_ (),
+      linearJoints_ (),
+      lowerBounds_ (vector_t::Constant
+		    (configSize_, -std::numeric_limits <value_type>::infinity ())),
+      upperBounds_ (vector_t::Constant
+		    (configSize_, std::numeric_limits <value_type>::infinity ()))
+    {
+      std::size_t index = 0;
+      const JointVector_t& jointVector (robot->getJointVector ());
+      for (JointVector_t::const_iterator itJoint = jointVector.begin ();
+	   itJoint != jointVector.end (); ++itJoint) {
+	if ((*itJoint)->numberDof () == 0) continue;
+	const size_type rank = (*itJoint)->rankInConfiguration ();
+	const size_type size = (*itJoint)->configSize ();
+	for (size_type i = 0; i < size; ++i) {
+	  if ((*itJoint)->isBounded (i)) {
+	    lowerBounds_ [rank + i] = (*itJoint)->lowerBound (i);
+	    upperBounds_ [rank + i] = (*itJoint)->upperBound (i);
+	  }
+	}
+	// Translations and bounded rotations are interpolated, sampled and
+	// measured coordinate by coordinate.
+	if (dynamic_cast <model::JointTranslation <1>*> (*itJoint) ||
+	    dynamic_cast <model::JointTranslation <2>*> (*itJoint) ||
+	    dynamic_cast <model::JointTranslation <3>*> (*itJoint) ||
+	    dynamic_cast <model::jointRotation::Bounded*> (*itJoint)) {
+	  linearJoints_.push_back (std::make_pair (*itJoint, index));
+	  if (!segments_.empty () &&
+	      segments_.back ().rank + segments_.back ().size == rank) {
+	    segments_.back ().size += size;
+	  } else {
+	    segments_.push_back (Segment (rank, size));
+	  }
+	} else if (dynamic_cast <model::jointRotation::UnBounded*>
+		   (*itJoint)) {
+	  rotations_.push_back (Rotation (*itJoint, rank, index, SO2));
+	} else if (dynamic_cast <model::JointSO3*> (*itJoint)) {
+	  rotations_.push_back (Rotation (*itJoint, rank, index, SO3));
+	} else {
+	  rotations_.push_back (Rotation (*itJoint, rank, index, OTHER));
+	}
+	++index;
+      }
+    }
+
+    vector_t ConfigurationLayout::coordinateWeights
+    (const std::vector <value_type>& jointWeights) const
+    {
+      vector_t weights (vector_t::Zero (configSize_));
+      for (std::vector <std::pair <JointPtr_t, std::size_t> >::const_iterator
+	     it = linearJoints_.begin (); it != linearJoints_.end (); ++it) {
+	weights.segment (it->first->rankInConfiguration (),
+			 it->first->configSize ()).setConstant
+	  (jointWeights [it->second]);
+      }
+      return weights;
+    }
+
+    void ConfigurationLayout::interpolate (ConfigurationIn_t q1,
+					   ConfigurationIn_t q2,
+					   const value_type& u,
+					   ConfigurationOut_t result) const
+    {
+      for (Segments_t::const_iterator it = segments_.begin ();
+	   it != segments_.end (); ++it) {
+	result.segment (it->rank, it->size) =
+	  (1-u) * q1.segment (it->rank, it->size) +
+	  u * q2.segment (it->rank, it->size);
+      }
+      for (Rotations_t::const_iterator it = rotations_.begin ();
+	   it != rotations_.end (); ++it) {
+	it->joint->configuration ()->interpolate (q1, q2, u, it->rank, result);
+      }
+    }
+
+    void ConfigurationLayout::uniformlySample (ConfigurationOut_t q,
+					       RandomEngine& engine) const
+    {
+      for (std::vector <std::pair <JointPtr_t, std::size_t> >::const_iterator
+	     it = linearJoints_.begin (); it != linearJoints_.end (); ++it) {
+	const JointPtr_t& joint (it->first);
+	const size_type rank = joint->rankInConfiguration ();
+	for (size_type i = 0; i < joint->configSize (); ++i) {
+	  if (!joint->isBounded (i)) {
+	    std::ostringstream oss;
+	    oss << "Cannot uniformly sample non bounded degree of freedom "
+		<< i << " of joint " << joint->name () << ".";
+	    throw std::runtime_error (oss.str ());
+	  }
+	  value_type lower = joint->lowerBound (i);
+	  value_type upper = joint->upperBound (i);
+	  q [rank + i] = engine.uniform (lower, upper);
+	}
+      }
+      for (Rotations_t::const_iterator it = rotations_.begin ();
+	   it != rotations_.end (); ++it) {
+	switch (it->type) {
+	case SO2:
+	  {
+	    value_type angle = engine.uniform (-M_PI, M_PI);
+	    q [it->rank + 0] = cos (angle);
+	    q [it->rank + 1] = sin (angle);
+	  }
+	  break;
+	case SO3:
+	  {
+	    value_type u1 = engine.uniform ();
+	    value_type u2 = engine.uniform ();
+	    value_type u3 = engine.uniform ();
+	    uniformQuaternion (u1, u2, u3, it->rank, q);
+	  }
+	  break;
+	default:
+	  it->joint->configuration ()->uniformlySample (it->rank, q);
+	}
+      }
+    }
+
+    void ConfigurationLayout::uniformQuaternion (value_type u1, value_type u2,
+						 value_type u3, size_type rank,
+						 ConfigurationOut_t q)
+    {
+      value_type a = sqrt (1 - u1), b = sqrt (u1);
+      q [rank + 0] = a * sin (2 * M_PI * u2);
+      q [rank + 1] = a * cos (2 * M_PI * u2);
+      q [rank + 2] = b * sin (2 * M_PI * u3);
+      q [rank + 3] = b * cos (2 * M_PI * u3);
+    }
+  } //   namespace core
+} // namespace hpp
@@ -17,83 +17,96 @@
 // <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <vector>
 #include <hpp/core/connected-component.hh>
 #include <hpp/core/edge.hh>
 
 namespace hpp {
   namespace core {
-    // Mark connected components of a list as unexplored.
-    void clean (ConnectedComponents_t& set)
+    typedef std::vector <ConnectedComponent*> Explored_t;
+
+    void ConnectedComponent::clean (Explored_t& explored)
     {
-      for (ConnectedComponents_t::iterator it = set.begin ();
-	   it != set.end (); ++it) {
+      for (Explored_t::iterator it = explored.begin ();
+	   it != explored.end (); ++it) {
 	(*it)->explored_ = false;
       }
     }
 
-    void ConnectedComponent::merge (const ConnectedComponentPtr_t& other)
+    ConnectedComponentPtr_t ConnectedComponent::representative ()
     {
-      // Tell other's nodes that they now belong to this connected component
-      for (Nodes_t::iterator itNode = other->nodes_.begin ();
-	   itNode != other->nodes_.end (); ++itNode) {
-	(*itNode)->connectedComponent (weak_.lock ());
+      if (!parent_) return weak_.lock ();
+      ConnectedComponentPtr_t root = parent_;
+      while (root->parent_) root = root->parent_;
+      // Path compression: connected components met on the way are made
+      // children of the root.
+      ConnectedComponentPtr_t next = parent_;
+      parent_ = root;
+      while (next != root) {
+	ConnectedComponentPtr_t after = next->parent_;
+	next->parent_ = root;
+	next = after;
       }
-      // Add other's nodes to this list.
+      return root;
+    }
+
+    void ConnectedComponent::merge (const ConnectedComponentPtr_t& other)
+    {
+      ConnectedComponentPtr_t self = weak_.lock ();
+      assert (!parent_ && !other->parent_);
+      // Add other's nodes to this list. Nodes are not visited: they find
+      // their new connected component through other's parent.
       nodes_.splice (nodes_.end (), other->nodes_);
+      other->parent_ = self;
+      // Both connected components are on a cycle and thus already agree,
+      // unless the edge closing the cycle is being inserted.
+      canReachGoal_ = canReachGoal_ || other->canReachGoal_;
 
       // Tell other's reachableTo's that other has been replaced by this
       for (ConnectedComponents_t::iterator itcc = other->reachableTo_.begin ();
 	   itcc != other->reachableTo_.end (); ++itcc) {
 	(*itcc)->reachableFrom_.erase (other);
-	(*itcc)->reachableFrom_.insert (weak_.lock ());
+	(*itcc)->reachableFrom_.insert (self);
+	reachableTo_.insert (*itcc);
       }
 
       // Tell other's reachableFrom's that other has been replaced by this
       for (ConnectedComponents_t::iterator itcc=other->reachableFrom_.begin ();
 	   itcc != other->reachableFrom_.end (); ++itcc) {
 	(*itcc)->reachableTo_.erase (other);
-	(*itcc)->reachableTo_.insert (weak_.lock ());
+	(*itcc)->reachableTo_.insert (self);
+	reachableFrom_.insert (*itcc);
       }
-      
-      ConnectedComponents_t tmp;
-      std::set_union (reachableTo_.begin (), reachableTo_.end (),
-		      other->reachableTo_.begin (), other->reachableTo_.end (),
-		      std::inserter (tmp, tmp.begin ()));
-      reachableTo_ = tmp; tmp.clear ();
+      other->reachableTo_.clear ();
+      other->reachableFrom_.clear ();
+
       reachableTo_.erase (other);
-      reachableTo_.erase (weak_.lock ());
-      std::set_union (reachableFrom_.begin (), reachableFrom_.end (),
-		      other->reachableFrom_.begin (),
-		      other->reachableFrom_.end (),
-		      std::inserter (tmp, tmp.begin ()));
-      reachableFrom_ = tmp; tmp.clear ();
+      reachableTo_.erase (self);
       reachableFrom_.erase (other);
-      reachableFrom_.erase (weak_.lock ());
+      reachableFrom_.erase (self);
     }
 
     bool ConnectedComponent::canReach (const ConnectedComponentPtr_t& cc)
     {
-      // Store visited connected components for further cleaning.
-      ConnectedComponents_t explored;
-      std::deque <ConnectedComponentWkPtr_t> queue;
-      queue.push_back (weak_);
+      // Visited connected components are kept alive by the roadmap during
+      // the search and are stored for further cleaning.
+      Explored_t explored;
+      Explored_t::size_type head = 0;
       explored_ = true;
-      explored.insert (weak_.lock ());
-      while (!queue.empty ()) {
-	ConnectedComponentPtr_t current = queue.front ().lock ();
-	queue.pop_front ();
-	if (current == cc) {
+      explored.push_back (this);
+      while (head < explored.size ()) {
+	ConnectedComponent* current = explored [head]; ++head;
+	if (current == cc.get ()) {
 	  clean (explored);
 	  return true;
 	}
 	for (ConnectedComponents_t::iterator itChild =
 	       current->reachableTo_.begin ();
 	     itChild != current->reachableTo_.end (); ++itChild) {
-	  ConnectedComponentPtr_t child = *itChild;
+	  ConnectedComponent* child = itChild->get ();
 	  if (!child->explored_) {
 	    child->explored_ = true;
-	    explored.insert (child);
-	    queue.push_back (child);
+	    explored.push_back (child);
 	  }
 	}
       }
@@ -104,65 +117,56 @@ namespace hpp {
     bool ConnectedComponent::canReach
     (const ConnectedComponentPtr_t& cc, ConnectedComponents_t& ccToThis)
     {
+      // Breadth first search forward from this connected component, the
+      // explored list is the queue.
+      Explored_t exploredForward;
+      Explored_t::size_type head = 0;
       bool reachable = false;
-      ConnectedComponentPtr_t thisCC = weak_.lock ();
-      // Store visited connected components
-      ConnectedComponents_t exploredForward;
-      std::deque <ConnectedComponentWkPtr_t> queue;
-      queue.push_back (weak_);
       explored_ = true;
-      exploredForward.insert (thisCC);
-      while (!queue.empty ()) {
-	ConnectedComponentPtr_t current = queue.front ().lock ();
-	queue.pop_front ();
-	if (current == cc) {
+      exploredForward.push_back (this);
+      while (head < exploredForward.size ()) {
+	ConnectedComponent* current = exploredForward [head]; ++head;
+	if (current == cc.get ()) {
 	  reachable = true;
-	  exploredForward.insert (current);
 	} else {
 	  for (ConnectedComponents_t::iterator itChild =
 		 current->reachableTo_.begin ();
 	       itChild != current->reachableTo_.end (); ++itChild) {
-	    ConnectedComponentPtr_t child = *itChild;
+	    ConnectedComponent* child = itChild->get ();
 	    if (!child->explored_) {
 	      child->explored_ = true;
-	      exploredForward.insert (child);
-	      queue.push_back (child);
+	      exploredForward.push_back (child);
 	    }
 	  }
 	}
       }
-      // Set visited connected components to unexplored
-      clean (exploredForward);
-      if (!reachable) return false;
-
-      // Store visited connected components
-      ConnectedComponents_t exploredBackward;
-      queue.push_back (cc);
-      cc->explored_ = true;
-      exploredBackward.insert (cc);
-      while (!queue.empty ()) {
-	ConnectedComponentPtr_t current = queue.front ().lock ();
-	queue.pop_front ();
-	if (current == thisCC) {
-	  exploredBackward.insert (current);
-	} else {
-	  for (ConnectedComponents_t::iterator itChild =
-		 current->reachableFrom_.begin ();
-	       itChild != current->reachableFrom_.end (); ++itChild) {
-	    ConnectedComponentPtr_t child = *itChild;
-	    if (!child->explored_) {
-	      child->explored_ = true;
-	      exploredBackward.insert (child);
-	      queue.push_back (child);
-	    }
+      if (!reachable) {
+	clean (exploredForward);
+	return false;
+      }
+      // Connected components explored forward keep explored_ set, so that
+      // the backward search from cc collects the components on a path
+      // between this and cc, that is the intersection of both searches.
+      Explored_t exploredBackward;
+      head = 0;
+      exploredBackward.push_back (cc.get ());
+      ccToThis.insert (cc);
+      cc->explored_ = false;
+      while (head < exploredBackward.size ()) {
+	ConnectedComponent* current = exploredBackward [head]; ++head;
+	if (current == this) continue;
+	for (ConnectedComponents_t::iterator itChild =
+	       current->reachableFrom_.begin ();
+	     itChild != current->reachableFrom_.end (); ++itChild) {
+	  ConnectedComponent* child = itChild->get ();
+	  if (child->explored_) {
+	    child->explored_ = false;
+	    exploredBackward.push_back (child);
+	    ccToThis.insert (*itChild);
 	  }
 	}
       }
-      // Set visited connected components to unexplored
-      clean (exploredBackward);
-      std::set_intersection (exploredForward.begin (), exploredForward.end (),
-			     exploredBackward.begin (), exploredBackward.end (),
-			     std::inserter (ccToThis, ccToThis.begin ()));
+      clean (exploredForward);
       return true;
     }
 
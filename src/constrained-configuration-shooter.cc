@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <hpp/model/device.hh>
+#include <hpp/model/joint.hh>
+#include <hpp/model/joint-configuration.hh>
+#include <hpp/core/config-projector.hh>
+#include <hpp/core/constrained-configuration-shooter.hh>
+#include <hpp/core/constraint-set.hh>
+#include <hpp/core/explicit-numerical-constraint.hh>
+#include <hpp/core/locked-joint.hh>
+#include <hpp/core/random-engine.hh>
+
+namespace hpp {
+  namespace core {
+    ConstrainedConfigurationShooterPtr_t
+    ConstrainedConfigurationShooter::create
+    (const DevicePtr_t& robot, const ConstraintSetPtr_t& constraints)
+    {
+      ConstrainedConfigurationShooter* ptr =
+	new ConstrainedConfigurationShooter (robot, constraints);
+      ConstrainedConfigurationShooterPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    ConstrainedConfigurationShooter::ConstrainedConfigurationShooter
+    (const DevicePtr_t& robot, const ConstraintSetPtr_t& constraints) :
+      robot_ (robot), layout_ (ConfigurationLayout::create (robot)),
+      free_ (), lower_ (), upper_ (), rotations_ (), lockedJoints_ (),
+      explicitConstraints_ ()
+    {
+      const size_type configSize = robot->configSize ();
+      // Coordinates determined by the constraints
+      std::vector <bool> fixed (configSize, false);
+      ConfigProjectorPtr_t configProjector;
+      if (constraints) configProjector = constraints->configProjector ();
+      if (configProjector) {
+	lockedJoints_ = configProjector->lockedJoints ();
+	for (LockedJoints_t::const_iterator itLocked = lockedJoints_.begin ();
+	     itLocked != lockedJoints_.end (); ++itLocked) {
+	  for (std::size_t i = 0; i < (*itLocked)->size (); ++i) {
+	    fixed [(*itLocked)->rankInConfiguration () + i] = true;
+	  }
+	}
+	NumericalConstraints_t functions
+	  (configProjector->numericalConstraints ());
+	for (NumericalConstraints_t::const_iterator itFunc =
+	       functions.begin (); itFunc != functions.end (); ++itFunc) {
+	  ExplicitNumericalConstraintPtr_t explicitConstraint
+	    (HPP_DYNAMIC_PTR_CAST (ExplicitNumericalConstraint, *itFunc));
+	  if (!explicitConstraint) continue;
+	  explicitConstraints_.push_back (explicitConstraint);
+	  const SizeIntervals_t& output (explicitConstraint->outputConf ());
+	  for (SizeIntervals_t::const_iterator itOut = output.begin ();
+	       itOut != output.end (); ++itOut) {
+	    for (size_type i = 0; i < (size_type) itOut->second; ++i) {
+	      fixed [itOut->first + i] = true;
+	    }
+	  }
+	}
+      }
+      // Free coordinates of vector spaces, including the extra
+      // configuration space.
+      const ConfigurationLayout::Segments_t& segments (layout_->segments ());
+      for (ConfigurationLayout::Segments_t::const_iterator it =
+	     segments.begin (); it != segments.end (); ++it) {
+	for (size_type i = 0; i < it->size; ++i) {
+	  if (!fixed [it->rank + i]) free_.push_back (it->rank + i);
+	}
+      }
+      const size_type extraDim = robot->extraConfigSpace ().dimension ();
+      const size_type offset = configSize - extraDim;
+      for (size_type i = 0; i < extraDim; ++i) {
+	if (!fixed [offset + i]) free_.push_back (offset + i);
+      }
+      lower_.resize (free_.size ());
+      upper_.resize (free_.size ());
+      for (std::size_t i = 0; i < free_.size (); ++i) {
+	if (free_ [i] < offset) {
+	  lower_ [i] = layout_->lowerBounds () [free_ [i]];
+	  upper_ [i] = layout_->upperBounds () [free_ [i]];
+	} else {
+	  lower_ [i] = robot->extraConfigSpace ().lower (free_ [i] - offset);
+	  upper_ [i] = robot->extraConfigSpace ().upper (free_ [i] - offset);
+	}
+	if (!(upper_ [i] - lower_ [i] < std::numeric_limits <value_type>::
+	      infinity ())) {
+	  std::ostringstream oss;
+	  oss << "Cannot uniformly sample non bounded configuration variable "
+	      << free_ [i] << ".";
+	  throw std::runtime_error (oss.str ());
+	}
+      }
+      // Locked joints and outputs of explicit constraints are whole joints.
+      const ConfigurationLayout::Rotations_t& rotations
+	(layout_->rotations ());
+      for (ConfigurationLayout::Rotations_t::const_iterator it =
+	     rotations.begin (); it != rotations.end (); ++it) {
+	if (!fixed [it->rank]) rotations_.push_back (*it);
+      }
+    }
+
+    void ConstrainedConfigurationShooter::init
+    (const ConstrainedConfigurationShooterPtr_t& self)
+    {
+      ConfigurationShooter::init (self);
+      weak_ = self;
+    }
+
+    void ConstrainedConfigurationShooter::sample (ConfigurationOut_t q) const
+    {
+      RandomEngine& engine (*randomEngine ());
+      for (std::size_t i = 0; i < free_.size (); ++i) {
+	q [free_ [i]] = engine.uniform (lower_ [i], upper_ [i]);
+      }
+      for (ConfigurationLayout::Rotations_t::const_iterator it =
+	     rotations_.begin (); it != rotations_.end (); ++it) {
+	switch (it->type) {
+	case ConfigurationLayout::SO2:
+	  {
+	    value_type angle = engine.uniform (-M_PI, M_PI);
+	    q [it->rank + 0] = cos (angle);
+	    q [it->rank + 1] = sin (angle);
+	  }
+	  break;
+	case ConfigurationLayout::SO3:
+	  {
+	    value_type u1 = engine.uniform ();
+	    value_type u2 = engine.uniform ();
+	    value_type u3 = engine.uniform ();
+	    ConfigurationLayout::uniformQuaternion (u1, u2, u3, it->rank, q);
+	  }
+	  break;
+	default:
+	  it->joint->configuration ()->uniformlySample (it->rank, q);
+	}
+      }
+      for (LockedJoints_t::const_iterator itLocked = lockedJoints_.begin ();
+	   itLocked != lockedJoints_.end (); ++itLocked) {
+	q.segment ((*itLocked)->rankInConfiguration (), (*itLocked)->size ())
+	  = (*itLocked)->value ();
+      }
+      // Outputs are computed once the inputs are set. An output of a
+      // constraint may be the input of a following one.
+      for (std::vector <ExplicitNumericalConstraintPtr_t>::const_iterator
+	     itExplicit = explicitConstraints_.begin ();
+	   itExplicit != explicitConstraints_.end (); ++itExplicit) {
+	(*itExplicit)->solve (q);
+      }
+    }
+
+    ConfigurationPtr_t ConstrainedConfigurationShooter::shoot () const
+    {
+      ConfigurationPtr_t config (new Configuration_t (robot_->configSize ()));
+      sample (*config);
+      return config;
+    }
+
+    void ConstrainedConfigurationShooter::shootBatch
+    (size_type n, matrixOut_t configurations) const
+    {
+      assert (configurations.cols () >= n);
+      for (size_type i = 0; i < n; ++i) {
+	sample (configurations.col (i));
+      }
+    }
+  } //   namespace core
+} // namespace hpp
@@ -16,6 +16,8 @@
 // hpp-core  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+#include <boost/bind.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <hpp/util/debug.hh>
 #include <hpp/model/configuration.hh>
@@ -30,6 +32,7 @@
 #include <hpp/core/roadmap.hh>
 #include <hpp/core/steering-method.hh>
 #include <hpp/core/basic-configuration-shooter.hh>
+#include "thread-pool.hh"
 
 namespace hpp {
   namespace core {
@@ -51,6 +54,7 @@ namespace hpp {
     DiffusingPlanner::DiffusingPlanner (const Problem& problem):
       PathPlanner (problem),
       configurationShooter_ (problem.configurationShooter()),
+      pathValidations_ (), threadPool_ (),
       qProj_ (problem.robot ()->configSize ())
     {
     }
@@ -59,6 +63,7 @@ namespace hpp {
 					const RoadmapPtr_t& roadmap) :
       PathPlanner (problem, roadmap),
       configurationShooter_ (problem.configurationShooter()),
+      pathValidations_ (), threadPool_ (),
       qProj_ (problem.robot ()->configSize ())
     {
     }
@@ -124,6 +129,10 @@ namespace hpp {
     ///  Note that edges are actually added to the roadmap after step 2 in order
     ///  to avoid iterating on the list of connected components while modifying
     ///  this list.
+    ///
+    ///  In steps 2 and 3, paths are computed first and validated together,
+    ///  possibly in parallel (see pathValidations). Results are then inserted
+    ///  in the roadmap in the order in which the paths were computed.
 
     void DiffusingPlanner::oneStep ()
     {
@@ -132,7 +141,6 @@ namespace hpp {
       typedef std::vector <DelayedEdge_t> DelayedEdges_t;
       DelayedEdges_t delayedEdges;
       DevicePtr_t robot (problem ().robot ());
-      PathValidationPtr_t pathValidation (problem ().pathValidation ());
       Nodes_t newNodes;
       PathPtr_t validPath, path;
       // Pick a random node
@@ -140,32 +148,51 @@ namespace hpp {
       //
       // First extend each connected component toward q_rand
       //
+      // Find nearest node of each connected component in one query.
+      // Connected components are sets of pointers: nearest nodes are
+      // sorted by index so that new nodes are inserted in the same order
+      // from run to run.
+      NearestNodes_t nearestNodes;
+      roadmap ()->nearestNodes (q_rand, nearestNodes);
+      std::vector <std::pair <std::size_t, NodePtr_t> > nearest;
       for (ConnectedComponents_t::const_iterator itcc =
 	     roadmap ()->connectedComponents ().begin ();
 	   itcc != roadmap ()->connectedComponents ().end (); ++itcc) {
-	// Find nearest node in roadmap
-	value_type distance;
-	NodePtr_t near = roadmap ()->nearestNode (q_rand, *itcc, distance);
+	NearestNodes_t::const_iterator itNear = nearestNodes.find (*itcc);
+	if (itNear == nearestNodes.end ()) continue;
+	nearest.push_back (std::make_pair (itNear->second.first->index (),
+					   itNear->second.first));
+      }
+      std::sort (nearest.begin (), nearest.end ());
+      std::vector <NodePtr_t> nearNodes;
+      ValidationTasks_t tasks;
+      for (std::size_t i = 0; i < nearest.size (); ++i) {
+	NodePtr_t near = nearest [i].second;
 	path = extend (near, q_rand);
 	if (path) {
-	  PathValidationReportPtr_t report;
-	  bool pathValid = pathValidation->validate (path, false, validPath,
-						     report);
-	  // Insert new path to q_near in roadmap
-	  value_type t_final = validPath->timeRange ().second;
-	  if (t_final != path->timeRange ().first) {
-	    bool success;
-	    ConfigurationPtr_t q_new (new Configuration_t
-				      (validPath->end ()));
-	    if (!pathValid || !belongs (q_new, newNodes)) {
-	      newNodes.push_back (roadmap ()->addNodeAndEdges
-				  (near, q_new, validPath));
-	    } else {
-	      // Store edges to add for later insertion.
-	      // Adding edges while looping on connected components is indeed
-	      // not recommended.
-	      delayedEdges.push_back (DelayedEdge_t (near, q_new, validPath));
-	    }
+	  nearNodes.push_back (near);
+	  tasks.push_back (ValidationTask (path));
+	}
+      }
+      validate (tasks);
+      for (std::size_t i = 0; i < tasks.size (); ++i) {
+	const NodePtr_t& near (nearNodes [i]);
+	path = tasks [i].path;
+	bool pathValid = tasks [i].valid;
+	validPath = tasks [i].validPart;
+	// Insert new path to q_near in roadmap
+	value_type t_final = validPath->timeRange ().second;
+	if (t_final != path->timeRange ().first) {
+	  ConfigurationPtr_t q_new (new Configuration_t
+				    (validPath->end ()));
+	  if (!pathValid || !belongs (q_new, newNodes)) {
+	    newNodes.push_back (roadmap ()->addNodeAndEdges
+				(near, q_new, validPath));
+	  } else {
+	    // Store edges to add for later insertion.
+	    // Adding edges while looping on connected components is indeed
+	    // not recommended.
+	    delayedEdges.push_back (DelayedEdge_t (near, q_new, validPath));
 	  }
 	}
       }
@@ -187,6 +214,8 @@ namespace hpp {
       // Second, try to connect new nodes together
       //
       const SteeringMethodPtr_t& sm (problem ().steeringMethod ());
+      std::vector <std::pair <NodePtr_t, NodePtr_t> > connections;
+      tasks.clear ();
       for (Nodes_t::const_iterator itn1 = newNodes.begin ();
 	   itn1 != newNodes.end (); ++itn1) {
 	for (Nodes_t::const_iterator itn2 = boost::next (itn1);
@@ -195,17 +224,65 @@ namespace hpp {
 	  ConfigurationPtr_t q2 ((*itn2)->configuration ());
 	  assert (*q1 != *q2);
 	  path = (*sm) (*q1, *q2);
-	  PathValidationReportPtr_t report;
-	  if (path && pathValidation->validate (path, false, validPath,
-						report)) {
-	    roadmap ()->addEdge (*itn1, *itn2, path);
-	    interval_t timeRange = path->timeRange ();
-	    roadmap ()->addEdge (*itn2, *itn1, path->extract
-				 (interval_t (timeRange.second,
-					      timeRange.first)));
+	  if (path) {
+	    connections.push_back (std::make_pair (*itn1, *itn2));
+	    tasks.push_back (ValidationTask (path));
 	  }
 	}
       }
+      validate (tasks);
+      for (std::size_t i = 0; i < tasks.size (); ++i) {
+	if (!tasks [i].valid) continue;
+	path = tasks [i].path;
+	roadmap ()->addEdge (connections [i].first, connections [i].second,
+			     path);
+	interval_t timeRange = path->timeRange ();
+	roadmap ()->addEdge (connections [i].second, connections [i].first,
+			     path->extract (interval_t (timeRange.second,
+							timeRange.first)));
+      }
+    }
+
+    void DiffusingPlanner::validate (ValidationTasks_t& tasks) const
+    {
+      const ConstraintSetPtr_t& constraints
+	(problem ().steeringMethod ()->constraints ());
+      std::size_t threads = std::min (pathValidations_.size (), tasks.size ());
+      if (constraints && constraints->configProjector ()) threads = 0;
+      if (threads <= 1) {
+	PathValidationPtr_t pathValidation (problem ().pathValidation ());
+	for (ValidationTasks_t::iterator it = tasks.begin ();
+	     it != tasks.end (); ++it) {
+	  PathValidationReportPtr_t report;
+	  it->valid = pathValidation->validate (it->path, false, it->validPart,
+						report);
+	}
+	return;
+      }
+      threadPool_->run (boost::bind (&DiffusingPlanner::validateTasks, this,
+				     &tasks, _1, threads), threads);
+      for (ValidationTasks_t::const_iterator it = tasks.begin ();
+	   it != tasks.end (); ++it) {
+	if (!it->error.empty ()) throw std::runtime_error (it->error);
+      }
+    }
+
+    void DiffusingPlanner::validateTasks (ValidationTasks_t* tasks,
+					  std::size_t thread,
+					  std::size_t threads) const
+    {
+      const PathValidationPtr_t& pathValidation (pathValidations_ [thread]);
+      for (std::size_t i = thread; i < tasks->size (); i += threads) {
+	ValidationTask& task ((*tasks) [i]);
+	// Exceptions cannot leave the thread, they are reported by validate.
+	try {
+	  PathValidationReportPtr_t report;
+	  task.valid = pathValidation->validate (task.path, false,
+						 task.validPart, report);
+	} catch (const std::exception& exc) {
+	  task.error = exc.what ();
+	}
+      }
     }
 
     void DiffusingPlanner::configurationShooter
@@ -214,6 +291,16 @@ namespace hpp {
       configurationShooter_ = shooter;
     }
 
+    void DiffusingPlanner::pathValidations
+    (const PathValidations_t& pathValidations)
+    {
+      pathValidations_ = pathValidations;
+      threadPool_.reset ();
+      if (pathValidations_.size () > 1) {
+	threadPool_ = ThreadPool::create (pathValidations_.size ());
+      }
+    }
+
 
   } // namespace core
 } // namespace hpp
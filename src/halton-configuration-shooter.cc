@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <hpp/model/device.hh>
+#include <hpp/model/joint.hh>
+#include <hpp/model/joint-configuration.hh>
+#include <hpp/core/configuration-layout.hh>
+#include <hpp/core/halton-configuration-shooter.hh>
+#include <hpp/core/random-engine.hh>
+
+namespace hpp {
+  namespace core {
+    namespace {
+      // Radical inverse of an integer in a given base: the digits of the
+      // integer are mirrored around the decimal point.
+      value_type radicalInverse (std::size_t index, std::size_t base)
+      {
+	value_type result = 0;
+	value_type factor = 1. / (value_type) base;
+	while (index > 0) {
+	  result += factor * (value_type) (index % base);
+	  index /= base;
+	  factor /= (value_type) base;
+	}
+	return result;
+      }
+
+      // First n prime numbers
+      std::vector <std::size_t> primes (std::size_t n)
+      {
+	std::vector <std::size_t> result;
+	for (std::size_t candidate = 2; result.size () < n; ++candidate) {
+	  bool prime = true;
+	  for (std::size_t i = 0; i < result.size () &&
+		 result [i] * result [i] <= candidate; ++i) {
+	    if (candidate % result [i] == 0) {
+	      prime = false;
+	      break;
+	    }
+	  }
+	  if (prime) result.push_back (candidate);
+	}
+	return result;
+      }
+    } // namespace
+
+    HaltonConfigurationShooterPtr_t HaltonConfigurationShooter::create
+    (const DevicePtr_t& robot)
+    {
+      HaltonConfigurationShooter* ptr = new HaltonConfigurationShooter (robot);
+      HaltonConfigurationShooterPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    HaltonConfigurationShooter::HaltonConfigurationShooter
+    (const DevicePtr_t& robot) :
+      robot_ (robot), layout_ (ConfigurationLayout::create (robot)),
+      lower_ (), upper_ (), primes_ (), shift_ (), shifted_ (false),
+      index_ (0)
+    {
+      const ConfigurationLayout::Segments_t& segments (layout_->segments ());
+      const ConfigurationLayout::Rotations_t& rotations
+	(layout_->rotations ());
+      const size_type extraDim = robot->extraConfigSpace ().dimension ();
+      // Linear dimensions first, then the dimensions of the rotations.
+      size_type linear = extraDim;
+      for (ConfigurationLayout::Segments_t::const_iterator it =
+	     segments.begin (); it != segments.end (); ++it) {
+	linear += it->size;
+      }
+      lower_.resize (linear);
+      upper_.resize (linear);
+      size_type d = 0;
+      for (ConfigurationLayout::Segments_t::const_iterator it =
+	     segments.begin (); it != segments.end (); ++it) {
+	lower_.segment (d, it->size) =
+	  layout_->lowerBounds ().segment (it->rank, it->size);
+	upper_.segment (d, it->size) =
+	  layout_->upperBounds ().segment (it->rank, it->size);
+	d += it->size;
+      }
+      for (size_type i = 0; i < extraDim; ++i, ++d) {
+	lower_ [d] = robot->extraConfigSpace ().lower (i);
+	upper_ [d] = robot->extraConfigSpace ().upper (i);
+      }
+      for (size_type i = 0; i < linear; ++i) {
+	if (!(upper_ [i] - lower_ [i] < std::numeric_limits <value_type>::
+	      infinity ())) {
+	  std::ostringstream oss;
+	  oss << "Cannot sample non bounded coordinate " << i
+	      << " of the Halton sequence.";
+	  throw std::runtime_error (oss.str ());
+	}
+      }
+      std::size_t dimension = linear;
+      for (ConfigurationLayout::Rotations_t::const_iterator it =
+	     rotations.begin (); it != rotations.end (); ++it) {
+	if (it->type == ConfigurationLayout::SO2) dimension += 1;
+	else if (it->type == ConfigurationLayout::SO3) dimension += 3;
+      }
+      primes_ = primes (dimension);
+      shift_.resize (dimension);
+    }
+
+    void HaltonConfigurationShooter::init
+    (const HaltonConfigurationShooterPtr_t& self)
+    {
+      ConfigurationShooter::init (self);
+      weak_ = self;
+    }
+
+    void HaltonConfigurationShooter::reset ()
+    {
+      index_ = 0;
+      shifted_ = false;
+    }
+
+    value_type HaltonConfigurationShooter::coordinate
+    (std::size_t dimension) const
+    {
+      value_type u = radicalInverse (index_, primes_ [dimension]) +
+	shift_ [dimension];
+      return u < 1 ? u : u - 1;
+    }
+
+    void HaltonConfigurationShooter::sample (ConfigurationOut_t q) const
+    {
+      if (!shifted_) {
+	RandomEngine& engine (*randomEngine ());
+	for (size_type i = 0; i < shift_.size (); ++i) {
+	  shift_ [i] = engine.uniform ();
+	}
+	shifted_ = true;
+      }
+      ++index_;
+      std::size_t d = 0;
+      const ConfigurationLayout::Segments_t& segments (layout_->segments ());
+      for (ConfigurationLayout::Segments_t::const_iterator it =
+	     segments.begin (); it != segments.end (); ++it) {
+	for (size_type i = 0; i < it->size; ++i, ++d) {
+	  q [it->rank + i] = lower_ [d] + (upper_ [d] - lower_ [d]) *
+	    coordinate (d);
+	}
+      }
+      const size_type extraDim = robot_->extraConfigSpace ().dimension ();
+      const size_type offset = robot_->configSize () - extraDim;
+      for (size_type i = 0; i < extraDim; ++i, ++d) {
+	q [offset + i] = lower_ [d] + (upper_ [d] - lower_ [d]) *
+	  coordinate (d);
+      }
+      const ConfigurationLayout::Rotations_t& rotations
+	(layout_->rotations ());
+      for (ConfigurationLayout::Rotations_t::const_iterator it =
+	     rotations.begin (); it != rotations.end (); ++it) {
+	switch (it->type) {
+	case ConfigurationLayout::SO2:
+	  {
+	    value_type angle = M_PI * (2 * coordinate (d) - 1);
+	    q [it->rank + 0] = cos (angle);
+	    q [it->rank + 1] = sin (angle);
+	  }
+	  d += 1;
+	  break;
+	case ConfigurationLayout::SO3:
+	  ConfigurationLayout::uniformQuaternion
+	    (coordinate (d), coordinate (d + 1), coordinate (d + 2),
+	     it->rank, q);
+	  d += 3;
+	  break;
+	default:
+	  it->joint->configuration ()->uniformlySample (it->rank, q);
+	}
+      }
+    }
+
+    ConfigurationPtr_t HaltonConfigurationShooter::shoot () const
+    {
+      ConfigurationPtr_t config (new Configuration_t (robot_->configSize ()));
+      sample (*config);
+      return config;
+    }
+
+    void HaltonConfigurationShooter::shootBatch
+    (size_type n, matrixOut_t configurations) const
+    {
+      assert (configurations.cols () >= n);
+      for (size_type i = 0; i < n; ++i) {
+	sample (configurations.col (i));
+      }
+    }
+  } //   namespace core
+} // namespace hpp
@@ -19,6 +19,7 @@
 #include <hpp/model/joint.hh>
 #include <hpp/model/joint-configuration.hh>
 #include <hpp/core/config-projector.hh>
+#include <hpp/core/configuration-layout.hh>
 #include <hpp/core/interpolated-path.hh>
 #include <hpp/core/projection-error.hh>
 
@@ -30,7 +31,7 @@ namespace hpp {
         value_type length) :
       parent_t (interval_t (0, length), device->configSize (),
 		device->numberDof ()),
-      device_ (device)
+      device_ (device), layout_ (ConfigurationLayout::create (device))
     {
       assert (init.size() == device_->configSize ());
       insert (0, init);
@@ -47,7 +48,7 @@ namespace hpp {
 				ConstraintSetPtr_t constraints) :
       parent_t (interval_t (0, length), device->configSize (),
 		device->numberDof (), constraints),
-      device_ (device)
+      device_ (device), layout_ (ConfigurationLayout::create (device))
     {
       assert (init.size() == device_->configSize ());
       insert (0, init);
@@ -56,8 +57,27 @@ namespace hpp {
       assert (length >= 0);
     }
 
+    InterpolatedPath::InterpolatedPath (const DevicePtr_t& device,
+				ConfigurationIn_t init,
+				ConfigurationIn_t end,
+				value_type length,
+				ConstraintSetPtr_t constraints,
+				const ConfigurationLayoutPtr_t& layout) :
+      parent_t (interval_t (0, length), device->configSize (),
+		device->numberDof (), constraints),
+      device_ (device), layout_ (layout)
+    {
+      assert (init.size() == device_->configSize ());
+      insert (0, init);
+      insert (length, end);
+      assert (device);
+      assert (layout);
+      assert (length >= 0);
+    }
+
     InterpolatedPath::InterpolatedPath (const InterpolatedPath& path) :
-      parent_t (path), device_ (path.device_), configs_ (path.configs_)
+      parent_t (path), device_ (path.device_), layout_ (path.layout_),
+      configs_ (path.configs_)
     {
       assert (initial().size() == device_->configSize ());
     }
@@ -65,7 +85,7 @@ namespace hpp {
     InterpolatedPath::InterpolatedPath (const InterpolatedPath& path,
 				const ConstraintSetPtr_t& constraints) :
       parent_t (path, constraints), device_ (path.device_),
-      configs_ (path.configs_)
+      layout_ (path.layout_), configs_ (path.configs_)
     {
     }
 
@@ -124,14 +144,7 @@ namespace hpp {
       const value_type T = itA->first - itB->first;
       const value_type u = (param - itB->first) / T;
 
-      // Loop over device joint and interpolate
-      const JointVector_t& jv (device_->getJointVector ());
-      for (model::JointVector_t::const_iterator itJoint = jv.begin ();
-	   itJoint != jv.end (); ++itJoint) {
-	std::size_t rank = (*itJoint)->rankInConfiguration ();
-	(*itJoint)->configuration ()->interpolate
-	  (itB->second, itA->second, u, rank, result);
-      }
+      layout_->interpolate (itB->second, itA->second, u, result);
       return true;
     }
 
@@ -151,7 +164,7 @@ namespace hpp {
       if (!success) throw projection_error
 		      ("Failed to apply constraints in InterpolatedPath::extract");
       InterpolatedPathPtr_t result = InterpolatedPath::create (device_, q1, q2, l,
-					       constraints ());
+					       constraints (), layout_);
 
       InterpolationPoints_t::const_iterator it = configs_.upper_bound (tmin);
       if (reverse)
@@ -0,0 +1,281 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <hpp/util/debug.hh>
+#include <hpp/model/device.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/configuration-shooter.hh>
+#include <hpp/core/constraint-set.hh>
+#include <hpp/core/distance.hh>
+#include <hpp/core/edge.hh>
+#include <hpp/core/lazy-prm-planner.hh>
+#include <hpp/core/nearest-neighbor.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/path.hh>
+#include <hpp/core/path-projector.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/problem.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/steering-method.hh>
+
+namespace hpp {
+  namespace core {
+    LazyPrmPlannerPtr_t LazyPrmPlanner::createWithRoadmap
+    (const Problem& problem, const RoadmapPtr_t& roadmap)
+    {
+      LazyPrmPlanner* ptr = new LazyPrmPlanner (problem, roadmap);
+      LazyPrmPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    LazyPrmPlannerPtr_t LazyPrmPlanner::create (const Problem& problem)
+    {
+      LazyPrmPlanner* ptr = new LazyPrmPlanner (problem);
+      LazyPrmPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    LazyPrmPlanner::LazyPrmPlanner (const Problem& problem) :
+      PathPlanner (problem),
+      configurationShooter_ (problem.configurationShooter ()),
+      numberOfNeighbors_ (10), nodes_ (), edges_ (), adjacency_ (),
+      reached_ ()
+    {
+    }
+
+    LazyPrmPlanner::LazyPrmPlanner (const Problem& problem,
+				    const RoadmapPtr_t& roadmap) :
+      PathPlanner (problem, roadmap),
+      configurationShooter_ (problem.configurationShooter ()),
+      numberOfNeighbors_ (10), nodes_ (), edges_ (), adjacency_ (),
+      reached_ ()
+    {
+    }
+
+    void LazyPrmPlanner::init (const LazyPrmPlannerWkPtr_t& weak)
+    {
+      PathPlanner::init (weak);
+      weakPtr_ = weak;
+    }
+
+    void LazyPrmPlanner::startSolve ()
+    {
+      PathPlanner::startSolve ();
+      // The roadmap may have been cleared or extended by another planner
+      // since the candidate edges were created.
+      nodes_.clear ();
+      edges_.clear ();
+      adjacency_.clear ();
+      reached_.clear ();
+    }
+
+    void LazyPrmPlanner::oneStep ()
+    {
+      DevicePtr_t robot (problem ().robot ());
+      ConfigValidationsPtr_t configValidations (problem ().configValidations());
+      ConstraintSetPtr_t constraints (problem ().constraints ());
+      // Shoot one random configuration per step, so that a step stays
+      // short when most configurations are invalid. Configurations are
+      // much cheaper to validate than paths.
+      ConfigurationPtr_t q_rand = configurationShooter_->shoot ();
+      if (constraints && !constraints->apply (*q_rand)) return;
+      robot->currentConfiguration (*q_rand);
+      robot->computeForwardKinematics ();
+      ValidationReportPtr_t report;
+      if (!configValidations->validate (*q_rand, report)) return;
+      roadmap ()->addNode (q_rand);
+      if (!addCandidateEdges ()) return;
+
+      // Validate the candidate edges along the shortest path until a path
+      // of valid edges is found or no path remains.
+      std::vector <std::size_t> candidates;
+      while (shortestPath (candidates)) {
+	bool pathValid = true;
+	for (std::vector <std::size_t>::const_iterator it = candidates.begin ();
+	     it != candidates.end (); ++it) {
+	  if (!validate (edges_ [*it])) {
+	    pathValid = false;
+	    break;
+	  }
+	}
+	if (pathValid) return;
+      }
+    }
+
+    bool LazyPrmPlanner::addCandidateEdges ()
+    {
+      const RoadmapPtr_t& r (roadmap ());
+      const std::size_t first = nodes_.size ();
+      const std::size_t n = r->configurations ().cols ();
+      if (n == first) return false;
+      nodes_.resize (n);
+      adjacency_.resize (n);
+      for (Nodes_t::const_reverse_iterator itNode = r->nodes ().rbegin ();
+	   itNode != r->nodes ().rend () && (*itNode)->index () >= first;
+	   ++itNode) {
+	nodes_ [(*itNode)->index ()] = *itNode;
+      }
+      // Each node is connected to its nearest nodes among the nodes
+      // registered before it. The n - i nodes registered from it on are
+      // found by the search as well and are skipped.
+      const DistancePtr_t& distance (problem ().distance ());
+      // Without a failed search since startSolve, the nodes reachable from
+      // the initial node are unknown.
+      bool reachesInit = reached_.empty ();
+      for (std::size_t i = first; i < n; ++i) {
+	const ConfigurationPtr_t& q (nodes_ [i]->configuration ());
+	Nodes_t nearest = r->nearestNeighbor ()->kNearest
+	  (q, numberOfNeighbors_ + n - i);
+	std::size_t k = 0;
+	for (Nodes_t::const_iterator itNode = nearest.begin ();
+	     itNode != nearest.end () && k < numberOfNeighbors_; ++itNode) {
+	  std::size_t j = (*itNode)->index ();
+	  if (j >= i) continue;
+	  adjacency_ [i].push_back (edges_.size ());
+	  adjacency_ [j].push_back (edges_.size ());
+	  edges_.push_back (CandidateEdge
+			    (i, j, (*distance) (*q, *(nodes_ [j]->
+						      configuration ()))));
+	  if (j < reached_.size () && reached_ [j]) reachesInit = true;
+	  ++k;
+	}
+      }
+      return reachesInit;
+    }
+
+    bool LazyPrmPlanner::shortestPath (std::vector <std::size_t>& candidates)
+    {
+      typedef std::pair <value_type, std::size_t> Entry_t;
+      const std::size_t n = nodes_.size ();
+      // Edges of the roadmap are marked by an invalid candidate edge index
+      const std::size_t noCandidate = edges_.size ();
+      std::vector <value_type> cost
+	(n, std::numeric_limits <value_type>::infinity ());
+      std::vector <std::size_t> previous (n, n);
+      std::vector <std::size_t> candidate (n, noCandidate);
+      std::priority_queue <Entry_t, std::vector <Entry_t>,
+			   std::greater <Entry_t> > open;
+      const std::size_t init = roadmap ()->initNode ()->index ();
+      cost [init] = 0;
+      open.push (Entry_t (0, init));
+      while (!open.empty ()) {
+	Entry_t top = open.top ();
+	open.pop ();
+	std::size_t i = top.second;
+	if (top.first > cost [i]) continue;
+	if (nodes_ [i]->isGoal ()) {
+	  candidates.clear ();
+	  for (; i != init; i = previous [i]) {
+	    if (candidate [i] != noCandidate) {
+	      candidates.push_back (candidate [i]);
+	    }
+	  }
+	  std::reverse (candidates.begin (), candidates.end ());
+	  return true;
+	}
+	// Validated edges
+	for (Node::Edges_t::const_iterator itEdge =
+	       nodes_ [i]->outEdges ().begin ();
+	     itEdge != nodes_ [i]->outEdges ().end (); ++itEdge) {
+	  std::size_t j = (*itEdge)->to ()->index ();
+	  value_type c = cost [i] + (*itEdge)->path ()->length ();
+	  if (c < cost [j]) {
+	    cost [j] = c;
+	    previous [j] = i;
+	    candidate [j] = noCandidate;
+	    open.push (Entry_t (c, j));
+	  }
+	}
+	// Candidate edges not validated yet. Valid candidate edges are
+	// already in the roadmap.
+	for (std::vector <std::size_t>::const_iterator itEdge =
+	       adjacency_ [i].begin (); itEdge != adjacency_ [i].end ();
+	     ++itEdge) {
+	  const CandidateEdge& edge (edges_ [*itEdge]);
+	  if (edge.status != UNKNOWN) continue;
+	  std::size_t j = (edge.n1 == i) ? edge.n2 : edge.n1;
+	  value_type c = cost [i] + edge.cost;
+	  if (c < cost [j]) {
+	    cost [j] = c;
+	    previous [j] = i;
+	    candidate [j] = *itEdge;
+	    open.push (Entry_t (c, j));
+	  }
+	}
+      }
+      // The nodes explored are the ones reachable from the initial node.
+      reached_.resize (n);
+      for (std::size_t i = 0; i < n; ++i) {
+	reached_ [i] = (cost [i] != std::numeric_limits <value_type>::
+			infinity ());
+      }
+      return false;
+    }
+
+    bool LazyPrmPlanner::validate (CandidateEdge& edge)
+    {
+      const NodePtr_t& n1 (nodes_ [edge.n1]);
+      const NodePtr_t& n2 (nodes_ [edge.n2]);
+      // The nodes may have been connected by another method, tryDirectPath
+      // for instance.
+      for (Node::Edges_t::const_iterator itEdge = n1->outEdges ().begin ();
+	   itEdge != n1->outEdges ().end (); ++itEdge) {
+	if ((*itEdge)->to () == n2) {
+	  edge.status = VALID;
+	  return true;
+	}
+      }
+      edge.status = INVALID;
+      const SteeringMethodPtr_t& sm (problem ().steeringMethod ());
+      PathValidationPtr_t pathValidation (problem ().pathValidation ());
+      PathProjectorPtr_t pathProjector (problem ().pathProjector ());
+      PathPtr_t path = (*sm) (*(n1->configuration ()), *(n2->configuration ()));
+      if (!path) return false;
+      PathPtr_t projPath, validPath;
+      if (pathProjector) {
+	if (!pathProjector->apply (path, projPath)) return false;
+      } else {
+	projPath = path;
+      }
+      PathValidationReportPtr_t report;
+      if (!pathValidation->validate (projPath, false, validPath, report)) {
+	hppDout (info, "candidate edge between nodes " << edge.n1 << " and "
+		 << edge.n2 << " is not valid");
+	return false;
+      }
+      edge.status = VALID;
+      roadmap ()->addEdge (n1, n2, projPath);
+      interval_t timeRange = projPath->timeRange ();
+      roadmap ()->addEdge (n2, n1, projPath->extract
+			   (interval_t (timeRange.second, timeRange.first)));
+      return true;
+    }
+
+    void LazyPrmPlanner::configurationShooter
+    (const ConfigurationShooterPtr_t& shooter)
+    {
+      configurationShooter_ = shooter;
+    }
+  } // namespace core
+} // namespace hpp
@@ -20,8 +20,12 @@
 # define HPP_CORE_NEAREST_NEIGHBOR_BASIC_HH
 
 # include <limits>
+# include <vector>
+# include <algorithm>
 # include <hpp/core/fwd.hh>
 # include <hpp/core/distance.hh>
+# include <hpp/core/node.hh>
+# include <hpp/core/connected-component.hh>
 # include <hpp/core/nearest-neighbor.hh>
 
 namespace hpp {
@@ -32,7 +36,8 @@ namespace hpp {
     {
     public:
 
-      Basic(const DistancePtr_t& distance) : distance_ (distance)
+      Basic(const DistancePtr_t& distance) : distance_ (distance), nodes_ (),
+					     size_ (0), distances_ ()
       {
       }
 
@@ -42,10 +47,26 @@ namespace hpp {
 
       virtual void clear ()
       {
+	nodes_.clear ();
+	size_ = 0;
       }
 
-      void addNode (const NodePtr_t&)
+      void addNode (const NodePtr_t& node)
       {
+	// Node i is column i of the configurations of the roadmap
+	assert (configurations_);
+	assert (node->index () == size_);
+	nodes_.push_back (node);
+	++size_;
+      }
+
+      virtual void build (const Nodes_t& nodes)
+      {
+	clear ();
+	for (Nodes_t::const_iterator itNode = nodes.begin ();
+	     itNode != nodes.end (); ++itNode) {
+	  addNode (*itNode);
+	}
       }
 
       virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
@@ -58,8 +79,10 @@ namespace hpp {
 	for (Nodes_t::const_iterator itNode =
 	       connectedComponent->nodes ().begin ();
 	     itNode != connectedComponent->nodes ().end (); ++itNode) {
-	  value_type d = (*distance_) (*(*itNode)->configuration (),
-				       *configuration);
+	  const Configuration_t& q (*(*itNode)->configuration ());
+	  // Screen the node with the cheap lower bound of the distance
+	  if (distance_->lowerBound (q, *configuration) >= distance) continue;
+	  value_type d = (*distance_) (q, *configuration);
 	  if (d < distance) {
 	    distance = d;
 	    result = *itNode;
@@ -69,6 +92,122 @@ namespace hpp {
 	return result;
       }
 
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				value_type& distance)
+      {
+	NodePtr_t result = NULL;
+	distance = std::numeric_limits <value_type>::infinity ();
+	if (size_ == 0) return result;
+	// Distances to all the nodes are computed in a single batch over the
+	// contiguous storage of the configurations.
+	computeDistances (configuration);
+	vector_t::Index i;
+	distance = distances_.head (size_).minCoeff (&i);
+	result = nodes_ [i];
+	return result;
+      }
+
+      virtual void search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest)
+      {
+	nearest.clear ();
+	if (size_ == 0) return;
+	computeDistances (configuration);
+	for (std::size_t i = 0; i < size_; ++i) {
+	  const NodePtr_t& node (nodes_ [i]);
+	  value_type d = distances_ [i];
+	  NearestNodes_t::iterator best =
+	    nearest.find (node->connectedComponent ());
+	  if (best == nearest.end ()) {
+	    nearest.insert (std::make_pair (node->connectedComponent (),
+					    std::make_pair (node, d)));
+	  } else if (d < best->second.second) {
+	    best->second = std::make_pair (node, d);
+	  }
+	}
+      }
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k)
+      {
+	if (k == 0) return Nodes_t ();
+	Candidates_t bounds;
+	computeLowerBounds (configuration, connectedComponent, bounds);
+	std::sort (bounds.begin (), bounds.end ());
+	// Distances are computed by increasing lower bound, until the lower
+	// bound exceeds the distance of the k-th nearest node found so far.
+	// candidates is a max-heap.
+	Candidates_t candidates;
+	for (Candidates_t::const_iterator it = bounds.begin ();
+	     it != bounds.end (); ++it) {
+	  if (candidates.size () == k &&
+	      it->first >= candidates.front ().first) break;
+	  value_type d = (*distance_) (*(it->second)->configuration (),
+				       *configuration);
+	  if (candidates.size () < k) {
+	    candidates.push_back (std::make_pair (d, it->second));
+	    std::push_heap (candidates.begin (), candidates.end ());
+	  } else if (d < candidates.front ().first) {
+	    std::pop_heap (candidates.begin (), candidates.end ());
+	    candidates.back () = std::make_pair (d, it->second);
+	    std::push_heap (candidates.begin (), candidates.end ());
+	  }
+	}
+	std::sort_heap (candidates.begin (), candidates.end ());
+	Nodes_t result;
+	for (Candidates_t::const_iterator it = candidates.begin ();
+	     it != candidates.end (); ++it) {
+	  result.push_back (it->second);
+	}
+	return result;
+      }
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k)
+      {
+	if (k == 0 || size_ == 0) return Nodes_t ();
+	computeDistances (configuration);
+	// Ties are broken by insertion order.
+	std::vector <std::pair <value_type, std::size_t> > candidates;
+	candidates.reserve (size_);
+	for (std::size_t i = 0; i < size_; ++i) {
+	  candidates.push_back (std::make_pair (distances_ [i], i));
+	}
+	const std::size_t n = std::min (k, size_);
+	std::partial_sort (candidates.begin (), candidates.begin () + n,
+			   candidates.end ());
+	Nodes_t result;
+	for (std::size_t i = 0; i < n; ++i) {
+	  result.push_back (nodes_ [candidates [i].second]);
+	}
+	return result;
+      }
+
+      virtual Nodes_t withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance)
+      {
+	Candidates_t candidates;
+	for (Nodes_t::const_iterator itNode =
+	       connectedComponent->nodes ().begin ();
+	     itNode != connectedComponent->nodes ().end (); ++itNode) {
+	  const Configuration_t& q (*(*itNode)->configuration ());
+	  if (distance_->lowerBound (q, *configuration) > maxDistance) continue;
+	  value_type d = (*distance_) (q, *configuration);
+	  if (d <= maxDistance) candidates.push_back (std::make_pair (d, *itNode));
+	}
+	std::sort (candidates.begin (), candidates.end ());
+	Nodes_t result;
+	for (Candidates_t::const_iterator it = candidates.begin ();
+	     it != candidates.end (); ++it) {
+	  result.push_back (it->second);
+	}
+	return result;
+      }
+
       virtual void merge (ConnectedComponentPtr_t, ConnectedComponentPtr_t)
       {
       }
@@ -80,7 +219,42 @@ namespace hpp {
       }
 
     private:
+      typedef std::vector <std::pair <value_type, NodePtr_t> > Candidates_t;
+
+      // Compute the distances between configuration and all the nodes into
+      // the first size_ elements of distances_.
+      void computeDistances (const ConfigurationPtr_t& configuration)
+      {
+	if ((std::size_t) distances_.size () < size_) {
+	  distances_.resize (configurations_->cols ());
+	}
+	distance_->compute (*configuration, configurations_->leftCols (size_),
+			    distances_.head (size_));
+      }
+
+      // Compute the lower bound of the distance between configuration and
+      // each node of the connected component.
+      void computeLowerBounds (const ConfigurationPtr_t& configuration,
+			       const ConnectedComponentPtr_t&
+			       connectedComponent,
+			       Candidates_t& bounds) const
+      {
+	bounds.reserve (connectedComponent->nodes ().size ());
+	for (Nodes_t::const_iterator itNode =
+	       connectedComponent->nodes ().begin ();
+	     itNode != connectedComponent->nodes ().end (); ++itNode) {
+	  bounds.push_back (std::make_pair
+			    (distance_->lowerBound (*(*itNode)->configuration (),
+						    *configuration), *itNode));
+	}
+      }
+
       const DistancePtr_t distance_;
+      // nodes_ [i] is the node of index i
+      std::vector <NodePtr_t> nodes_;
+      std::size_t size_;
+      // distances computed by the last batch
+      vector_t distances_;
     }; // class Basic
     } // namespace nearestNeighbor
   } // namespace core
@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_NEAREST_NEIGHBOR_COMPONENT_LABELS_HH
+# define HPP_CORE_NEAREST_NEIGHBOR_COMPONENT_LABELS_HH
+
+# include <algorithm>
+# include <map>
+# include <vector>
+# include <hpp/core/fwd.hh>
+
+namespace hpp {
+  namespace core {
+    namespace nearestNeighbor {
+    /// Integer labels of connected components
+    ///
+    /// Nearest neighbor structures store one label per node instead of
+    /// lists of nodes per connected component. Labels of merged connected
+    /// components are joined in a union-find structure, so that merging
+    /// two connected components does not require to visit the nodes.
+    class ComponentLabels
+    {
+    public:
+      ComponentLabels () : parent_ (), size_ (), components_ (), labels_ (),
+			   generation_ (0)
+      {
+      }
+
+      /// Get the label of a connected component
+      ///
+      /// A new label is created if the connected component is unknown.
+      /// The returned label is the representative of its class.
+      std::size_t label (const ConnectedComponentPtr_t& connectedComponent)
+      {
+	Labels_t::iterator it = labels_.find (connectedComponent);
+	if (it != labels_.end ()) return it->second;
+	std::size_t label = parent_.size ();
+	parent_.push_back (label);
+	size_.push_back (1);
+	components_.push_back (connectedComponent);
+	labels_.insert (std::make_pair (connectedComponent, label));
+	return label;
+      }
+
+      /// Get the label of a connected component if it exists
+      /// \retval label representative label of the connected component
+      /// \return whether the connected component has a label.
+      bool find (const ConnectedComponentPtr_t& connectedComponent,
+		 std::size_t& label) const
+      {
+	Labels_t::const_iterator it = labels_.find (connectedComponent);
+	if (it == labels_.end ()) return false;
+	label = it->second;
+	return true;
+      }
+
+      /// Get the representative label of a label
+      std::size_t find (std::size_t label)
+      {
+	while (parent_ [label] != label) {
+	  // path halving
+	  parent_ [label] = parent_ [parent_ [label]];
+	  label = parent_ [label];
+	}
+	return label;
+      }
+
+      /// Get the connected component of a representative label
+      const ConnectedComponentPtr_t& component (std::size_t root) const
+      {
+	return components_ [root];
+      }
+
+      /// Merge connected component cc2 into cc1
+      void merge (const ConnectedComponentPtr_t& cc1,
+		  const ConnectedComponentPtr_t& cc2)
+      {
+	std::size_t r1 = label (cc1);
+	std::size_t r2 = label (cc2);
+	labels_.erase (cc2);
+	if (r1 == r2) return;
+	// union by size, the representative is then associated to cc1.
+	if (size_ [r1] < size_ [r2]) std::swap (r1, r2);
+	parent_ [r2] = r1;
+	size_ [r1] += size_ [r2];
+	components_ [r2].reset ();
+	components_ [r1] = cc1;
+	labels_ [cc1] = r1;
+	++generation_;
+      }
+
+      /// Make a sorted list of labels representative
+      /// \param labels sorted list of labels,
+      /// \param generation generation the labels were made representative
+      ///        with, updated by this method.
+      void update (std::vector <std::size_t>& labels, std::size_t& generation)
+      {
+	if (generation == generation_) return;
+	for (std::vector <std::size_t>::iterator it = labels.begin ();
+	     it != labels.end (); ++it) {
+	  *it = find (*it);
+	}
+	std::sort (labels.begin (), labels.end ());
+	labels.erase (std::unique (labels.begin (), labels.end ()),
+		      labels.end ());
+	generation = generation_;
+      }
+
+      /// Insert a label in a sorted list of labels if not already in it
+      static void insert (std::vector <std::size_t>& labels,
+			  std::size_t label)
+      {
+	std::vector <std::size_t>::iterator it = std::lower_bound
+	  (labels.begin (), labels.end (), label);
+	if (it == labels.end () || *it != label) {
+	  labels.insert (it, label);
+	}
+      }
+
+      /// Number of labels created so far
+      std::size_t size () const
+      {
+	return parent_.size ();
+      }
+
+      /// Incremented each time two classes of labels are merged
+      ///
+      /// Structures caching representative labels use this counter to
+      /// detect that their cache is outdated.
+      std::size_t generation () const
+      {
+	return generation_;
+      }
+
+      void clear ()
+      {
+	parent_.clear ();
+	size_.clear ();
+	components_.clear ();
+	labels_.clear ();
+	++generation_;
+      }
+
+    private:
+      typedef std::map <ConnectedComponentPtr_t, std::size_t> Labels_t;
+      std::vector <std::size_t> parent_;
+      std::vector <std::size_t> size_;
+      std::vector <ConnectedComponentPtr_t> components_;
+      Labels_t labels_;
+      std::size_t generation_;
+    }; // class ComponentLabels
+    } // namespace nearestNeighbor
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_NEAREST_NEIGHBOR_COMPONENT_LABELS_HH
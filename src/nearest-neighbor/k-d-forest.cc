@@ -0,0 +1,554 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <hpp/util/debug.hh>
+#include <hpp/model/device.hh>
+#include <hpp/core/random-engine.hh>
+#include <hpp/core/weighed-distance.hh>
+#include "nearest-neighbor/k-d-tree.hh"
+#include "nearest-neighbor/k-d-forest.hh"
+
+namespace hpp {
+  namespace core {
+    namespace nearestNeighbor {
+    namespace {
+      // label meaning "any connected component"
+      const std::size_t noLabel = std::numeric_limits <std::size_t>::max ();
+
+      // number of widest dimentions the splitting dimention is drawn among
+      const std::size_t randomDims = 5;
+
+      // Compare one coordinate of the configurations of two points
+      struct CoordinateLess
+      {
+	CoordinateLess (const matrix_t& configurations, size_type dim) :
+	  configurations_ (configurations), dim_ (dim)
+	{
+	}
+	bool operator () (std::size_t p1, std::size_t p2) const
+	{
+	  return configurations_ (dim_, p1) < configurations_ (dim_, p2);
+	}
+	const matrix_t& configurations_;
+	size_type dim_;
+      }; // struct CoordinateLess
+
+      // Whether one coordinate of the configuration of a point is not
+      // greater than a value
+      struct CoordinateNotGreater
+      {
+	CoordinateNotGreater (const matrix_t& configurations, size_type dim,
+			      value_type value) :
+	  configurations_ (configurations), dim_ (dim), value_ (value)
+	{
+	}
+	bool operator () (std::size_t p) const
+	{
+	  return !(configurations_ (dim_, p) > value_);
+	}
+	const matrix_t& configurations_;
+	size_type dim_;
+	value_type value_;
+      }; // struct CoordinateNotGreater
+    } // namespace
+
+    KDForest::KDForest (const DevicePtr_t& robot,
+			const DistancePtr_t& distance, std::size_t trees,
+			std::size_t bucketSize) :
+      distance_ (distance), bucketSize_ (bucketSize), checks_ (256),
+      boxWeights_ (), trees_ (trees), points_ (),
+      pointLabels_ (), labels_ (), visits_ (), query_ (0),
+      randomEngine_ (RandomEngine::create ())
+    {
+      assert (trees > 0);
+      assert (bucketSize_ > 0);
+      WeighedDistancePtr_t weighedDistance =
+	HPP_DYNAMIC_PTR_CAST (WeighedDistance, distance);
+      if (!weighedDistance) {
+	// order the branches with unit weighs.
+	weighedDistance = WeighedDistance::create
+	  (robot, std::vector <value_type>
+	   (robot->getJointVector ().size (), 1.0));
+      }
+      boxWeights_ = KDTree::boxWeights (weighedDistance);
+      clear ();
+    }
+
+    KDForest::~KDForest ()
+    {
+    }
+
+    void KDForest::checks (std::size_t checks)
+    {
+      checks_ = checks;
+    }
+
+    void KDForest::clear ()
+    {
+      for (std::vector <Tree>::iterator itTree = trees_.begin ();
+	   itTree != trees_.end (); ++itTree) {
+	itTree->treeNodes.assign (1, TreeNode ());
+	itTree->slots.assign (bucketSize_, 0);
+      }
+      points_.clear ();
+      pointLabels_.clear ();
+      labels_.clear ();
+      visits_.clear ();
+    }
+
+    void KDForest::addNode (const NodePtr_t& node)
+    {
+      const Configuration_t& q (*(node->configuration ()));
+      std::size_t point = addPoint (node);
+      std::size_t label = pointLabels_ [point];
+      visits_.push_back (0);
+      for (std::size_t tree = 0; tree < trees_.size (); ++tree) {
+	std::size_t current = 0;
+	while (true) {
+	  labels (tree, current);
+	  TreeNode& treeNode (trees_ [tree].treeNodes [current]);
+	  ComponentLabels::insert (treeNode.labels, label);
+	  if (treeNode.child != 0) {
+	    current = treeNode.child;
+	    if (q [treeNode.splitDim] > treeNode.splitValue) ++current;
+	  } else if (treeNode.size < bucketSize_) {
+	    trees_ [tree].slots [treeNode.bucket + treeNode.size] = point;
+	    ++treeNode.size;
+	    break;
+	  } else {
+	    // the leaf becomes an inner node, go on from it.
+	    split (trees_ [tree], current);
+	  }
+	}
+      }
+    }
+
+    void KDForest::build (const Nodes_t& nodes)
+    {
+      clear ();
+      points_.reserve (nodes.size ());
+      pointLabels_.reserve (nodes.size ());
+      for (Nodes_t::const_iterator itNode = nodes.begin ();
+	   itNode != nodes.end (); ++itNode) {
+	addPoint (*itNode);
+      }
+      visits_.assign (points_.size (), 0);
+      for (std::vector <Tree>::iterator itTree = trees_.begin ();
+	   itTree != trees_.end (); ++itTree) {
+	Points_t points (points_.size ());
+	for (std::size_t point = 0; point < points_.size (); ++point) {
+	  points [point] = point;
+	}
+	itTree->slots.clear ();
+	build (*itTree, 0, points.begin (), points.end ());
+	for (TreeNodes_t::iterator it = itTree->treeNodes.begin ();
+	     it != itTree->treeNodes.end (); ++it) {
+	  it->generation = labels_.generation ();
+	}
+      }
+    }
+
+    std::size_t KDForest::addPoint (const NodePtr_t& node)
+    {
+      // Point i is column i of the configurations of the roadmap
+      assert (configurations_);
+      assert (node->index () == points_.size ());
+      std::size_t point = points_.size ();
+      points_.push_back (node);
+      pointLabels_.push_back (labels_.label (node->connectedComponent ()));
+      return point;
+    }
+
+    KDForest::Points_t::iterator KDForest::splitPoints
+    (TreeNode& treeNode, Points_t::iterator begin, Points_t::iterator end)
+      const
+    {
+      const size_type dim = boxWeights_.size ();
+      vector_t actualLower (dim);
+      actualLower.setConstant (+std::numeric_limits <value_type>::infinity ());
+      vector_t actualUpper (dim);
+      actualUpper.setConstant (-std::numeric_limits <value_type>::infinity ());
+      for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	   ++itPoint) {
+	ConfigurationIn_t q (configurations_->col (*itPoint));
+	for (size_type i=0; i < dim; ++i) {
+	  if (q [i] < actualLower [i]) actualLower [i] = q [i];
+	  if (q [i] > actualUpper [i]) actualUpper [i] = q [i];
+	}
+      }
+      // Draw the splitting dimention among the widest bounded ones. Other
+      // dimentions are split only if bounded ones cannot.
+      std::vector <std::pair <value_type, size_type> > widths;
+      for (size_type i=0; i < dim; ++i) {
+	value_type width = (actualUpper [i] - actualLower [i]) *
+	  boxWeights_ [i];
+	if (width > 0) widths.push_back (std::make_pair (width, i));
+      }
+      for (size_type i=0; widths.empty () && i < dim; ++i) {
+	if (actualUpper [i] > actualLower [i]) {
+	  widths.push_back (std::make_pair (actualUpper [i] - actualLower [i],
+					    i));
+	}
+      }
+      if (widths.empty ()) {
+	throw std::runtime_error
+	  ("Attempt to split a KDForest bucket of identical configurations");
+      }
+      std::size_t candidates = std::min (randomDims, widths.size ());
+      std::partial_sort (widths.begin (), widths.begin () + candidates,
+			 widths.end (),
+			 std::greater <std::pair <value_type, size_type> > ());
+      size_type splitDim = widths [randomEngine_->uniformInt (candidates)].second;
+      // Split at the median value of the coordinates. If the median is the
+      // maximal value, split below it so that both children are not empty.
+      Points_t::iterator median = begin + (end - begin - 1)/2;
+      std::nth_element (begin, median, end,
+			CoordinateLess (*configurations_, splitDim));
+      value_type splitValue = (*configurations_)
+	(splitDim, *median);
+      if (splitValue == actualUpper [splitDim]) {
+	splitValue = actualLower [splitDim];
+	for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	     ++itPoint) {
+	  value_type value = (*configurations_)
+	    (splitDim, *itPoint);
+	  if (value < actualUpper [splitDim] && value > splitValue) {
+	    splitValue = value;
+	  }
+	}
+      }
+      treeNode.splitDim = splitDim;
+      treeNode.splitValue = splitValue;
+      return std::partition (begin, end,
+			     CoordinateNotGreater (*configurations_, splitDim,
+						   splitValue));
+    }
+
+    void KDForest::split (Tree& tree, std::size_t leaf)
+    {
+      const std::size_t bucket = tree.treeNodes [leaf].bucket;
+      const std::size_t size = tree.treeNodes [leaf].size;
+      Points_t points (tree.slots.begin () + bucket,
+		       tree.slots.begin () + bucket + size);
+      Points_t::iterator middle = splitPoints (tree.treeNodes [leaf],
+					       points.begin (), points.end ());
+      // The inferior child keeps the bucket of the leaf, a new bucket is
+      // allocated for the superior child.
+      const std::size_t child = tree.treeNodes.size ();
+      tree.treeNodes.resize (child + 2);
+      TreeNode& parent (tree.treeNodes [leaf]);
+      parent.child = child;
+      parent.size = 0;
+      TreeNode& infChild (tree.treeNodes [child]);
+      TreeNode& supChild (tree.treeNodes [child + 1]);
+      infChild.bucket = bucket;
+      supChild.bucket = tree.slots.size ();
+      infChild.generation = supChild.generation = labels_.generation ();
+      tree.slots.resize (tree.slots.size () + bucketSize_);
+      for (Points_t::const_iterator itPoint = points.begin ();
+	   itPoint != points.end (); ++itPoint) {
+	TreeNode& treeNode (itPoint < middle ? infChild : supChild);
+	tree.slots [treeNode.bucket + treeNode.size] = *itPoint;
+	++treeNode.size;
+	ComponentLabels::insert (treeNode.labels, label (*itPoint));
+      }
+    }
+
+    void KDForest::build (Tree& tree, std::size_t index,
+			  Points_t::iterator begin, Points_t::iterator end)
+    {
+      if ((std::size_t) (end - begin) <= bucketSize_) {
+	TreeNode& leaf (tree.treeNodes [index]);
+	leaf.bucket = tree.slots.size ();
+	leaf.size = end - begin;
+	tree.slots.resize (tree.slots.size () + bucketSize_);
+	std::copy (begin, end, tree.slots.begin () + leaf.bucket);
+	for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	     ++itPoint) {
+	  ComponentLabels::insert (leaf.labels, label (*itPoint));
+	}
+	return;
+      }
+      Points_t::iterator middle = splitPoints (tree.treeNodes [index], begin,
+					       end);
+      std::size_t child = tree.treeNodes.size ();
+      tree.treeNodes.resize (child + 2);
+      tree.treeNodes [index].child = child;
+      build (tree, child, begin, middle);
+      build (tree, child + 1, middle, end);
+      const TreeNode& infChild (tree.treeNodes [child]);
+      const TreeNode& supChild (tree.treeNodes [child + 1]);
+      std::vector <std::size_t> labels;
+      std::set_union (infChild.labels.begin (), infChild.labels.end (),
+		      supChild.labels.begin (), supChild.labels.end (),
+		      std::back_inserter (labels));
+      tree.treeNodes [index].labels.swap (labels);
+    }
+
+    NodePtr_t KDForest::search (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				value_type& distance)
+    {
+      distance = std::numeric_limits <value_type>::infinity ();
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return NULL;
+      Candidates_t candidates;
+      search (*configuration, label, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      if (candidates.empty ()) return NULL;
+      distance = candidates.top ().first;
+      return candidates.top ().second;
+    }
+
+    NodePtr_t KDForest::search (const ConfigurationPtr_t& configuration,
+				value_type& distance)
+    {
+      distance = std::numeric_limits <value_type>::infinity ();
+      Candidates_t candidates;
+      search (*configuration, noLabel, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      if (candidates.empty ()) return NULL;
+      distance = candidates.top ().first;
+      return candidates.top ().second;
+    }
+
+    void KDForest::search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest)
+    {
+      nearest.clear ();
+      // Nearest node of each connected component indexed by label
+      Nearest_t best (labels_.size (), std::make_pair
+		      (NodePtr_t (NULL),
+		       std::numeric_limits <value_type>::infinity ()));
+      search (*configuration, best);
+      for (std::size_t label = 0; label < best.size (); ++label) {
+	if (best [label].first) {
+	  nearest.insert (std::make_pair (labels_.component (label),
+					  best [label]));
+	}
+      }
+    }
+
+    Nodes_t KDForest::kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k)
+    {
+      Candidates_t candidates;
+      std::size_t label;
+      if (k == 0 || !labels_.find (connectedComponent, label)) {
+	return Nodes_t ();
+      }
+      search (*configuration, label, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDForest::kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k)
+    {
+      if (k == 0) return Nodes_t ();
+      Candidates_t candidates;
+      search (*configuration, noLabel, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDForest::withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance)
+    {
+      Candidates_t candidates;
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return Nodes_t ();
+      search (*configuration, label,
+	      std::numeric_limits <std::size_t>::max (), maxDistance,
+	      candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDForest::sortedNodes (Candidates_t& candidates)
+    {
+      Nodes_t result;
+      while (!candidates.empty ()) {
+	result.push_front (candidates.top ().second);
+	candidates.pop ();
+      }
+      return result;
+    }
+
+    void KDForest::search (const Configuration_t& configuration,
+			   std::size_t label, std::size_t k,
+			   const value_type& maxDistance,
+			   Candidates_t& candidates)
+    {
+      ++query_;
+      std::size_t checked = 0;
+      Branches_t branches;
+      for (std::size_t tree = 0; tree < trees_.size (); ++tree) {
+	branches.push (Branch (0, tree, 0));
+      }
+      while (!branches.empty ()) {
+	if (checks_ != 0 && checked >= checks_ && !candidates.empty ()) return;
+	const Branch branch (branches.top ());
+	branches.pop ();
+	// Distance of the worst candidate that can still be accepted
+	value_type bound = maxDistance;
+	if (candidates.size () == k) bound = candidates.top ().first;
+	// bounds of branches are squared distances, the remaining branches
+	// are all farther.
+	if (branch.bound > bound*bound) return;
+	const Tree& tree (trees_ [branch.tree]);
+	std::size_t index = branch.index;
+	while (true) {
+	  if (label != noLabel) {
+	    const std::vector <std::size_t>& subtreeLabels
+	      (labels (branch.tree, index));
+	    if (!std::binary_search (subtreeLabels.begin (),
+				     subtreeLabels.end (), label)) break;
+	  }
+	  const TreeNode& treeNode (tree.treeNodes [index]);
+	  if (treeNode.child == 0) {
+	    for (std::size_t slot = treeNode.bucket;
+		 slot < treeNode.bucket + treeNode.size; ++slot) {
+	      std::size_t point = tree.slots [slot];
+	      if (visits_ [point] == query_) continue;
+	      visits_ [point] = query_;
+	      if (label != noLabel && this->label (point) != label) continue;
+	      ++checked;
+	      // Screen the point with the cheap lower bound of the distance
+	      bound = maxDistance;
+	      if (candidates.size () == k) bound = candidates.top ().first;
+	      if (lowerBound (configuration, point) > bound) continue;
+	      value_type distance = this->distance (configuration, point);
+	      if (distance > maxDistance) continue;
+	      if (candidates.size () < k) {
+		candidates.push (Candidate_t (distance, points_ [point]));
+	      } else if (distance < candidates.top ().first) {
+		candidates.pop ();
+		candidates.push (Candidate_t (distance, points_ [point]));
+	      }
+	    }
+	    break;
+	  }
+	  // The far child is explored later, its bound accumulates the
+	  // squared distances to the splitting planes.
+	  size_type dim = treeNode.splitDim;
+	  std::size_t nearChild = treeNode.child;
+	  std::size_t farChild = treeNode.child + 1;
+	  if (configuration [dim] > treeNode.splitValue) {
+	    std::swap (nearChild, farChild);
+	  }
+	  value_type offset = (configuration [dim] - treeNode.splitValue) *
+	    boxWeights_ [dim];
+	  value_type farBound = branch.bound + offset*offset;
+	  if (farBound <= bound*bound) {
+	    branches.push (Branch (farBound, branch.tree, farChild));
+	  }
+	  index = nearChild;
+	}
+      }
+    }
+
+    void KDForest::search (const Configuration_t& configuration,
+			   Nearest_t& nearest)
+    {
+      ++query_;
+      std::size_t checked = 0;
+      // number of connected components without nearest node yet
+      std::size_t missing = labels (0, 0).size ();
+      Branches_t branches;
+      for (std::size_t tree = 0; tree < trees_.size (); ++tree) {
+	branches.push (Branch (0, tree, 0));
+      }
+      while (!branches.empty ()) {
+	// Once the number of checks is exceeded, only the connected
+	// components without nearest node are searched.
+	const bool exceeded = checks_ != 0 && checked >= checks_;
+	if (exceeded && missing == 0) return;
+	const Branch branch (branches.top ());
+	branches.pop ();
+	const Tree& tree (trees_ [branch.tree]);
+	std::size_t index = branch.index;
+	while (true) {
+	  // The subtree is explored if it may contain a node closer than the
+	  // current nearest node of one of its connected components.
+	  const std::vector <std::size_t>& subtreeLabels
+	    (labels (branch.tree, index));
+	  value_type bound = -1;
+	  for (std::vector <std::size_t>::const_iterator it =
+		 subtreeLabels.begin (); it != subtreeLabels.end (); ++it) {
+	    if (!nearest [*it].first) {
+	      bound = std::numeric_limits <value_type>::infinity ();
+	    } else if (!exceeded) {
+	      bound = std::max (bound, nearest [*it].second);
+	    }
+	  }
+	  if (bound < 0 || branch.bound > bound*bound) break;
+	  const TreeNode& treeNode (tree.treeNodes [index]);
+	  if (treeNode.child == 0) {
+	    for (std::size_t slot = treeNode.bucket;
+		 slot < treeNode.bucket + treeNode.size; ++slot) {
+	      std::size_t point = tree.slots [slot];
+	      if (visits_ [point] == query_) continue;
+	      visits_ [point] = query_;
+	      ++checked;
+	      std::pair <NodePtr_t, value_type>& best (nearest [label (point)]);
+	      if (lowerBound (configuration, point) > best.second) continue;
+	      value_type distance = this->distance (configuration, point);
+	      if (!best.first) --missing;
+	      if (distance < best.second || !best.first) {
+		best.first = points_ [point];
+		best.second = distance;
+	      }
+	    }
+	    break;
+	  }
+	  size_type dim = treeNode.splitDim;
+	  std::size_t nearChild = treeNode.child;
+	  std::size_t farChild = treeNode.child + 1;
+	  if (configuration [dim] > treeNode.splitValue) {
+	    std::swap (nearChild, farChild);
+	  }
+	  value_type offset = (configuration [dim] - treeNode.splitValue) *
+	    boxWeights_ [dim];
+	  value_type farBound = branch.bound + offset*offset;
+	  if (farBound <= bound*bound) {
+	    branches.push (Branch (farBound, branch.tree, farChild));
+	  }
+	  index = nearChild;
+	}
+      }
+    }
+
+    void KDForest::merge (ConnectedComponentPtr_t cc1,
+			  ConnectedComponentPtr_t cc2)
+    {
+      // Labels of cc2 now resolve to cc1, the trees are updated lazily
+      labels_.merge (cc1, cc2);
+    }
+    } // namespace nearestNeighbor
+  } // namespace core
+} // namespace hpp
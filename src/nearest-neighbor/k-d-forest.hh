@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_NEAREST_NEIGHBOR_K_D_FOREST_HH
+# define HPP_CORE_NEAREST_NEIGHBOR_K_D_FOREST_HH
+
+# include <queue>
+# include <vector>
+# include <hpp/core/distance.hh>
+# include <hpp/core/node.hh>
+# include <hpp/core/nearest-neighbor.hh>
+# include "nearest-neighbor/component-labels.hh"
+
+namespace hpp {
+  namespace core {
+    namespace nearestNeighbor {
+    // Randomized k-dimentional trees for approximate nearest neighbour
+    // research
+    //
+    // Each tree splits its nodes along a dimention drawn at random among
+    // the widest ones, so that the trees partition the space differently.
+    // A query explores the branches of all trees in a single priority queue
+    // ordered by distance to the splitting planes, and stops after checking
+    // a given number of points. The result is then not always the
+    // nearest node, but the cost of a query does not blow up with the
+    // dimention of the configuration space as it does for exact trees.
+    //
+    // Layout and connected components are handled as in KDTree.
+    class KDForest : public NearestNeighbor
+    {
+    public:
+      // constructor
+      KDForest (const DevicePtr_t& robot, const DistancePtr_t& distance,
+		std::size_t trees, std::size_t bucketSize);
+
+      virtual ~KDForest ();
+
+      // set the maximal number of points checked by a query, 0 for no
+      // limit (256 by default).
+      // The more checks, the higher the probability to find the nearest
+      // nodes and the longer the query.
+      void checks (std::size_t checks);
+
+      std::size_t checks () const
+      {
+	return checks_;
+      }
+
+      // set the engine drawing the splitting dimensions. It is used when
+      // the trees are built or split, ProblemSolver gives each forest a
+      // stream of the engine of the problem.
+      void randomEngine (const RandomEnginePtr_t& randomEngine)
+      {
+	randomEngine_ = randomEngine;
+      }
+
+      virtual void clear ();
+
+      virtual void addNode (const NodePtr_t& node);
+
+      virtual void build (const Nodes_t& nodes);
+
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				value_type& distance);
+
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				value_type& distance);
+
+      // the nearest node of each connected component is approximate, but
+      // each connected component gets one even when the number of checks
+      // is exceeded.
+      virtual void search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest);
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k);
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k);
+
+      virtual Nodes_t withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance);
+
+      virtual void merge (ConnectedComponentPtr_t cc1,
+			  ConnectedComponentPtr_t cc2);
+
+      virtual DistancePtr_t distance () const
+      {
+	return distance_;
+      }
+
+    private:
+      // Node of a tree
+      struct TreeNode
+      {
+	TreeNode () : splitDim (0), splitValue (0), child (0), bucket (0),
+		      size (0), generation (0), labels ()
+	{
+	}
+	// splitting dimention and value, meaningless for leaves
+	size_type splitDim;
+	value_type splitValue;
+	// index of the inferior child, the superior child follows it.
+	// 0 for leaves since the root is never a child.
+	std::size_t child;
+	// first slot of the bucket and number of points, for leaves only
+	std::size_t bucket;
+	std::size_t size;
+	// labels generation the labels below were computed with
+	std::size_t generation;
+	// sorted representative labels of the points below the tree node
+	std::vector <std::size_t> labels;
+      }; // struct TreeNode
+      typedef std::vector <TreeNode> TreeNodes_t;
+      typedef std::vector <std::size_t> Points_t;
+
+      // Tree nodes and buckets of one tree, all trees store the same points
+      struct Tree
+      {
+	TreeNodes_t treeNodes;
+	Points_t slots;
+      }; // struct Tree
+
+      // Branch of a tree waiting to be explored, ordered by increasing
+      // squared distance to the splitting planes on the path to it.
+      struct Branch
+      {
+	Branch (value_type bound, std::size_t tree, std::size_t index) :
+	  bound (bound), tree (tree), index (index)
+	{
+	}
+	bool operator< (const Branch& other) const
+	{
+	  return bound > other.bound;
+	}
+	value_type bound;
+	std::size_t tree;
+	std::size_t index;
+      }; // struct Branch
+      typedef std::priority_queue <Branch> Branches_t;
+
+      DistancePtr_t distance_;
+      std::size_t bucketSize_;
+      std::size_t checks_;
+      // weights of the coordinates in the distance to the splitting planes
+      vector_t boxWeights_;
+      std::vector <Tree> trees_;
+      // points_ [i] is the node of index i, its configuration is column i
+      // of configurations_.
+      std::vector <NodePtr_t> points_;
+      Points_t pointLabels_;
+      ComponentLabels labels_;
+      // query during which each point was last checked, so that the points
+      // met in several trees are checked once.
+      Points_t visits_;
+      std::size_t query_;
+      // draws the splitting dimentions. Each forest has its own engine so
+      // that forests built in different threads do not share a state and
+      // are built identically from one run to the other with the same seed.
+      RandomEnginePtr_t randomEngine_;
+
+      // distance between a configuration and a point
+      value_type distance (ConfigurationIn_t configuration,
+			   std::size_t point) const
+      {
+	return (*distance_) (configuration, configurations_->col (point));
+      }
+
+      // cheap lower bound of the distance between a configuration and a
+      // point
+      value_type lowerBound (ConfigurationIn_t configuration,
+			     std::size_t point) const
+      {
+	return distance_->lowerBound (configuration,
+				      configurations_->col (point));
+      }
+
+      // store a node as a new point, return the index of the point
+      std::size_t addPoint (const NodePtr_t& node);
+
+      // representative label of a point
+      std::size_t label (std::size_t point)
+      {
+	return pointLabels_ [point] = labels_.find (pointLabels_ [point]);
+      }
+
+      // update labels of a tree node after connected components merged
+      const std::vector <std::size_t>& labels (std::size_t tree,
+					       std::size_t index)
+      {
+	TreeNode& treeNode (trees_ [tree].treeNodes [index]);
+	labels_.update (treeNode.labels, treeNode.generation);
+	return treeNode.labels;
+      }
+
+      // Choose at random the splitting dimention among the widest ones,
+      // split at the median value and partition the points accordingly.
+      // return the first point of the superior child.
+      Points_t::iterator splitPoints (TreeNode& treeNode,
+				      Points_t::iterator begin,
+				      Points_t::iterator end) const;
+
+      // Split a full leaf of a tree into two leaves
+      void split (Tree& tree, std::size_t leaf);
+
+      // Build the subtree rooted at tree.treeNodes [index]
+      void build (Tree& tree, std::size_t index, Points_t::iterator begin,
+		  Points_t::iterator end);
+
+      // Max-heap of the best candidates found so far
+      typedef std::pair <value_type, NodePtr_t> Candidate_t;
+      typedef std::priority_queue <Candidate_t> Candidates_t;
+
+      // search at most k nodes closer than maxDistance, in the connected
+      // component of the given label, or in the whole roadmap if the label
+      // is not a valid label.
+      void search (const Configuration_t& configuration, std::size_t label,
+		   std::size_t k, const value_type& maxDistance,
+		   Candidates_t& candidates);
+
+      // search nearest node of each connected component
+      typedef std::vector <std::pair <NodePtr_t, value_type> > Nearest_t;
+      void search (const Configuration_t& configuration, Nearest_t& nearest);
+
+      // pop candidates into a list sorted by increasing distance
+      static Nodes_t sortedNodes (Candidates_t& candidates);
+    }; // class KDForest
+    } // namespace nearestNeighbor
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_NEAREST_NEIGHBOR_K_D_FOREST_HH
@@ -18,12 +18,18 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include <hpp/util/debug.hh>
 #include <hpp/core/distance.hh>
 #include <hpp/core/node.hh>
 #include <hpp/model/joint.hh>
 #include <hpp/model/joint-configuration.hh>
 #include <hpp/model/device.hh>
+#include <hpp/core/configuration-layout.hh>
 #include <hpp/core/weighed-distance.hh>
 #include "../src/nearest-neighbor/k-d-tree.hh"
 
@@ -32,37 +38,61 @@ using namespace std;
 namespace hpp {
   namespace core {
     namespace nearestNeighbor {
-    // Constructor with the mother tree node (same bounds)
-    KDTree::KDTree (const KDTreePtr_t mother, size_type splitDim) :
-      robot_(mother->robot_),
-      dim_(mother->dim_),
-      distance_(mother->distance_),
-      weights_ (mother->weights_),
-      nodesMap_(),
-      bucketSize_(mother->bucketSize_),
-      bucket_(0),
-      splitDim_(splitDim),
-      upperBounds_(mother->upperBounds_),
-      lowerBounds_(mother->lowerBounds_),
-      supChild_(0x0),
-      infChild_(0x0)
-    {
-    }
+    namespace {
+      // label meaning "any connected component"
+      const std::size_t noLabel = std::numeric_limits <std::size_t>::max ();
+
+      // Compare one coordinate of the configurations of two points
+      struct CoordinateLess
+      {
+	CoordinateLess (const matrix_t& configurations, size_type dim) :
+	  configurations_ (configurations), dim_ (dim)
+	{
+	}
+	bool operator () (std::size_t p1, std::size_t p2) const
+	{
+	  return configurations_ (dim_, p1) < configurations_ (dim_, p2);
+	}
+	const matrix_t& configurations_;
+	size_type dim_;
+      }; // struct CoordinateLess
+
+      // Whether one coordinate of the configuration of a point is not
+      // greater than a value
+      struct CoordinateNotGreater
+      {
+	CoordinateNotGreater (const matrix_t& configurations, size_type dim,
+			      value_type value) :
+	  configurations_ (configurations), dim_ (dim), value_ (value)
+	{
+	}
+	bool operator () (std::size_t p) const
+	{
+	  return !(configurations_ (dim_, p) > value_);
+	}
+	const matrix_t& configurations_;
+	size_type dim_;
+	value_type value_;
+      }; // struct CoordinateNotGreater
+    } // namespace
 
     KDTree::KDTree (const DevicePtr_t& robot, const DistancePtr_t& distance,
 		    int bucketSize) :
       robot_(robot),
       dim_(),
       distance_(HPP_DYNAMIC_PTR_CAST (WeighedDistance, distance)),
-      weights_ (robot->configSize ()),
-      nodesMap_(),
       bucketSize_(bucketSize),
-      bucket_(0),
-      splitDim_(),
+      threads_(1),
+      rebuildFactor_(2),
       upperBounds_(),
       lowerBounds_(),
-      supChild_(),
-      infChild_()
+      boxWeights_(),
+      treeNodes_(),
+      slots_(),
+      points_(),
+      pointLabels_(),
+      labels_(),
+      insertions_(0)
        {
 	 JointVector_t jointVector = robot_->getJointVector ();
 	 if (!distance_) {
@@ -70,128 +100,364 @@ namespace hpp {
 	   distance_ = WeighedDistance::create
 	     (robot_, std::vector <value_type> (jointVector.size (), 1.0));
 	 }
-	 size_type i=0;
-	 // Fill vector of weights. index of vector is configuration coordinate
-	 // and not joint rank in robot.
-	 for (JointVector_t::const_iterator itJoint = jointVector.begin ();
-	      itJoint != jointVector.end (); ++itJoint) {
-	   weights_.segment ((*itJoint)->rankInConfiguration (),
-			     (*itJoint)->configSize ()).setConstant
-         (distance_->getWeight (i));
-	   ++i;
-	 }
+      boxWeights_ = boxWeights (distance_);
       this->findDeviceBounds();
       dim_ = lowerBounds_.size();
-      splitDim_ = 0;
-      supChild_ = NULL;
-      infChild_ = NULL;
+      assert (bucketSize_ > 0);
+      clear ();
     }
 
     KDTree::~KDTree() {
-      clear ();
     }
 
-    // find the leaf node in the tree for the configuration of the node
-    KDTreePtr_t KDTree::findLeaf (const NodePtr_t& node) {
-      KDTreePtr_t CurrentTree = this;
-      CurrentTree->nodesMap_[node->connectedComponent()];
-      while ( CurrentTree->supChild_ != NULL && CurrentTree->infChild_ != NULL)
-	{
-	  if ( (*(node->configuration()))[CurrentTree->supChild_->splitDim_]
-	       > CurrentTree->supChild_->lowerBounds_[CurrentTree->supChild_
-						      ->splitDim_] )  {
-	    CurrentTree = CurrentTree->supChild_;
-	    CurrentTree->nodesMap_[node->connectedComponent()];
-	  }
-	  else {
-	    CurrentTree = CurrentTree->infChild_;
-	    CurrentTree->nodesMap_[node->connectedComponent()];
-	  }
-	}
-      return CurrentTree;
+    vector_t KDTree::boxWeights (const WeighedDistancePtr_t& distance)
+    {
+      // Only the coordinates of bounded dimentions give a lower bound of the
+      // distance to a box: coordinates of quaternions q and -q are far
+      // apart although they represent the same rotation and angles of
+      // unbounded rotations wrap around. The layout gives a weight to the
+      // coordinates of vector space joints only.
+      std::vector <value_type> weights (distance->size ());
+      for (std::size_t i = 0; i < weights.size (); ++i) {
+	weights [i] = distance->getWeight (i);
+      }
+      return distance->layout ()->coordinateWeights (weights);
     }
 
-
     void KDTree::addNode (const NodePtr_t& node) {
-
-      KDTreePtr_t Leaf = this->findLeaf(node);
-      if ( Leaf->bucket_ < bucketSize_ ) {
-	Leaf->nodesMap_[node->connectedComponent()].push_front(node);
-	Leaf->bucket_++;
+      const Configuration_t& q (*(node->configuration ()));
+      std::size_t point = addPoint (node);
+      std::size_t label = pointLabels_ [point];
+      // Go down the tree and register the label along the path
+      std::size_t current = 0;
+      std::size_t depth = 0;
+      while (true) {
+	labels (current);
+	ComponentLabels::insert (treeNodes_ [current].labels, label);
+	TreeNode& treeNode (treeNodes_ [current]);
+	if (treeNode.child != 0) {
+	  current = treeNode.child;
+	  if (q [treeNode.splitDim] > treeNode.splitValue) ++current;
+	  ++depth;
+	}
+	else if (treeNode.size < bucketSize_) {
+	  slots_ [treeNode.bucket + treeNode.size] = point;
+	  ++treeNode.size;
+	  break;
+	}
+	else {
+	  // the leaf becomes an inner node, go on from it.
+	  split (current);
+	}
       }
-      else {
-	Leaf->split();
-	for ( NodesMap_t::iterator map = Leaf->nodesMap_.begin();
-	      map != Leaf->nodesMap_.end(); ++map) {
-	  for (Nodes_t::iterator it = map->second.begin ();
-	       it != map->second.end (); ++it) {
-	    Leaf->addNode(*it);
-	  }
-	  map->second.clear();
+      // Rebuild the tree if the leaf is too deep with respect to a
+      // balanced tree containing the same number of points.
+      // A quarter of the nodes at least must have been inserted since last
+      // rebuild, so that the cost of rebuilding is amortized.
+      ++insertions_;
+      if (rebuildFactor_ > 0 && 4 * insertions_ >= points_.size ()) {
+	value_type balancedDepth = 1 + log (1 + (value_type) points_.size ()/
+					    (value_type) bucketSize_)/log (2.);
+	if (depth > rebuildFactor_ * balancedDepth) {
+	  hppDout (info, "Rebuilding KDTree: depth " << depth << " for "
+		   << points_.size () << " nodes.");
+	  rebuild ();
 	}
-	Leaf->addNode(node);
       }
     }
 
+    void KDTree::build (const Nodes_t& nodes)
+    {
+      clear ();
+      points_.reserve (nodes.size ());
+      pointLabels_.reserve (nodes.size ());
+      for (Nodes_t::const_iterator itNode = nodes.begin ();
+	   itNode != nodes.end (); ++itNode) {
+	addPoint (*itNode);
+      }
+      rebuild ();
+    }
+
+    std::size_t KDTree::addPoint (const NodePtr_t& node)
+    {
+      // Point i is column i of the configurations of the roadmap
+      assert (configurations_);
+      assert (node->index () == points_.size ());
+      std::size_t point = points_.size ();
+      points_.push_back (node);
+      pointLabels_.push_back (labels_.label (node->connectedComponent ()));
+      return point;
+    }
+
+    void KDTree::buildThreads (std::size_t threads)
+    {
+      threads_ = threads;
+    }
+
+    void KDTree::rebuildFactor (value_type factor)
+    {
+      rebuildFactor_ = factor;
+    }
 
     void KDTree::clear() {
-      nodesMap_.clear();
-      if (infChild_ != NULL ) {
-	delete infChild_;
-	infChild_ = NULL;
+      treeNodes_.assign (1, TreeNode ());
+      slots_.assign (bucketSize_, 0);
+      points_.clear ();
+      pointLabels_.clear ();
+      labels_.clear ();
+      insertions_ = 0;
+    }
+
+    KDTree::Points_t::iterator KDTree::splitPoints
+    (TreeNode& treeNode, Points_t::iterator begin, Points_t::iterator end)
+      const
+    {
+      // Compute actual bounds of node configurations
+      vector_t actualLower (dim_);
+      actualLower.setConstant (+std::numeric_limits <value_type>::infinity ());
+      vector_t actualUpper (dim_);
+      actualUpper.setConstant (-std::numeric_limits <value_type>::infinity ());
+      for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	   ++itPoint) {
+	ConfigurationIn_t q (configurations_->col (*itPoint));
+	for (size_type i=0; i < q.size (); ++i) {
+	  if (q [i] < actualLower [i]) {
+	    actualLower [i] = q [i];
+	  }
+	  if (q [i] > actualUpper [i]) {
+	    actualUpper [i] = q [i];
+	  }
+	}
       }
-      if (supChild_ != NULL ) {
-	delete supChild_;
-	supChild_ = NULL;
+      // Split the widest bounded dimention since splitting other dimentions
+      // does not help pruning. Other dimentions are split only if bounded
+      // ones cannot.
+      value_type dimWidth = 0.;
+      size_type splitDim = 0;
+      for (size_type i=0 ; i < actualUpper.size (); i++) {
+	if ((actualUpper [i] - actualLower [i]) * boxWeights_ [i] > dimWidth ) {
+	  dimWidth = (actualUpper [i] - actualLower [i]) * boxWeights_ [i];
+	  splitDim = i;
+	}
+      }
+      for (size_type i=0 ; dimWidth <= 0 && i < actualUpper.size (); i++) {
+	if (actualUpper [i] > actualLower [i]) {
+	  dimWidth = actualUpper [i] - actualLower [i];
+	  splitDim = i;
+	}
       }
+      if (dimWidth <= 0) {
+	throw std::runtime_error
+	  ("Attempt to split a KDTree bucket of identical configurations");
+      }
+      // Split at the median value of the coordinates. If the median is the
+      // maximal value, split below it so that both children are not empty.
+      Points_t::iterator median = begin + (end - begin - 1)/2;
+      std::nth_element (begin, median, end,
+			CoordinateLess (*configurations_, splitDim));
+      value_type splitValue = (*configurations_)
+	(splitDim, *median);
+      if (splitValue == actualUpper [splitDim]) {
+	splitValue = actualLower [splitDim];
+	for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	     ++itPoint) {
+	  value_type value = (*configurations_)
+	    (splitDim, *itPoint);
+	  if (value < actualUpper [splitDim] && value > splitValue) {
+	    splitValue = value;
+	  }
+	}
+      }
+      treeNode.splitDim = splitDim;
+      treeNode.splitValue = splitValue;
+      return std::partition (begin, end,
+			     CoordinateNotGreater (*configurations_, splitDim,
+						   splitValue));
     }
 
-
-    void KDTree::split() {
-      if ( infChild_ != NULL || supChild_ != NULL ) {
+    void KDTree::split (std::size_t leaf) {
+      if (treeNodes_ [leaf].child != 0) {
 	// Error, you're triing to split a non leaf part of the KDTree
 	throw std::runtime_error
 	  ("Attempt to split the KDTree in a non leaf part");
       }
-      // Compute actual bounds of node configurations
-      vector_t actualLower (robot_->configSize ());
-      actualLower.setConstant (+std::numeric_limits <value_type>::infinity ());
-      vector_t actualUpper (robot_->configSize ());
-      actualUpper.setConstant (-std::numeric_limits <value_type>::infinity ());
-      std::vector <value_type> values (bucket_);
-      for (NodesMap_t::iterator itCC = nodesMap_.begin();
-	   itCC != nodesMap_.end(); ++itCC) {
-	Nodes_t nodes = itCC->second;
-	for (Nodes_t::const_iterator itNode = nodes.begin ();
-	     itNode != nodes.end (); ++itNode) {
-	  const Configuration_t& q (*((*itNode)->configuration ()));
-	  for (size_type i=0; i < q.size (); ++i) {
-	    if (q [i] < actualLower [i]) {
-	      actualLower [i] = q [i];
-	    }
-	    if (q [i] > actualUpper [i]) {
-	      actualUpper [i] = q [i];
-	    }
+      const std::size_t bucket = treeNodes_ [leaf].bucket;
+      const std::size_t size = treeNodes_ [leaf].size;
+      Points_t points (slots_.begin () + bucket,
+		       slots_.begin () + bucket + size);
+      Points_t::iterator middle = splitPoints (treeNodes_ [leaf],
+					       points.begin (), points.end ());
+
+      // The inferior child keeps the bucket of the leaf, a new bucket is
+      // allocated for the superior child.
+      const std::size_t child = treeNodes_.size ();
+      treeNodes_.resize (child + 2);
+      TreeNode& parent (treeNodes_ [leaf]);
+      parent.child = child;
+      parent.size = 0;
+      TreeNode& infChild (treeNodes_ [child]);
+      TreeNode& supChild (treeNodes_ [child + 1]);
+      infChild.bucket = bucket;
+      supChild.bucket = slots_.size ();
+      infChild.generation = supChild.generation = labels_.generation ();
+      slots_.resize (slots_.size () + bucketSize_);
+      for (Points_t::const_iterator itPoint = points.begin ();
+	   itPoint != points.end (); ++itPoint) {
+	TreeNode& treeNode (itPoint < middle ? infChild : supChild);
+	slots_ [treeNode.bucket + treeNode.size] = *itPoint;
+	++treeNode.size;
+	ComponentLabels::insert (treeNode.labels, label (*itPoint));
+      }
+    }
+
+    void KDTree::rebuild ()
+    {
+      // Labels are made representative first, since they are only read
+      // while building.
+      Points_t points (points_.size ());
+      for (std::size_t point = 0; point < points_.size (); ++point) {
+	points [point] = point;
+	label (point);
+      }
+      treeNodes_.assign (1, TreeNode ());
+      slots_.clear ();
+      insertions_ = 0;
+      if (threads_ <= 1) {
+	build (treeNodes_, slots_, 0, points.begin (), points.end ());
+      } else {
+	// Split the largest subtree until there is one subtree per thread,
+	// then build the subtrees in parallel.
+	std::vector <Task_t> tasks (1, Task_t (0, std::make_pair
+					       (points.begin (),
+						points.end ())));
+	std::vector <std::size_t> innerNodes;
+	while (tasks.size () < threads_) {
+	  std::vector <Task_t>::iterator largest = tasks.begin ();
+	  for (std::vector <Task_t>::iterator it = tasks.begin ();
+	       it != tasks.end (); ++it) {
+	    if (it->second.second - it->second.first >
+		largest->second.second - largest->second.first) largest = it;
+	  }
+	  Points_t::iterator begin = largest->second.first;
+	  Points_t::iterator end = largest->second.second;
+	  if ((std::size_t) (end - begin) <= bucketSize_) break;
+	  std::size_t index = largest->first;
+	  Points_t::iterator middle = splitPoints (treeNodes_ [index],
+						   begin, end);
+	  std::size_t child = treeNodes_.size ();
+	  treeNodes_.resize (child + 2);
+	  treeNodes_ [index].child = child;
+	  innerNodes.push_back (index);
+	  *largest = Task_t (child, std::make_pair (begin, middle));
+	  tasks.push_back (Task_t (child + 1, std::make_pair (middle, end)));
+	}
+	std::vector <Fragment> fragments (tasks.size ());
+	boost::thread_group threads;
+	for (std::size_t i = 0; i < tasks.size (); ++i) {
+	  threads.create_thread (boost::bind (&KDTree::buildFragment, this,
+					      &fragments [i],
+					      tasks [i].second.first,
+					      tasks [i].second.second));
+	}
+	threads.join_all ();
+	for (std::size_t i = 0; i < tasks.size (); ++i) {
+	  if (!fragments [i].error.empty ()) {
+	    throw std::runtime_error (fragments [i].error);
 	  }
+	  splice (tasks [i].first, fragments [i]);
+	}
+	// Labels of the nodes split sequentially, children first.
+	for (std::vector <std::size_t>::reverse_iterator it =
+	       innerNodes.rbegin (); it != innerNodes.rend (); ++it) {
+	  unionLabels (treeNodes_, *it);
 	}
       }
-      // Split the widest dimention
-      double dimWidth = 0.;
-      size_type splitDim;
-      for (size_type i=0 ; i < actualUpper.size (); i++) {
-	if ((actualUpper [i] - actualLower [i]) * weights_ [i] > dimWidth ) {
-	  dimWidth =  actualUpper [i] - actualLower [i];
-	  splitDim = i;
+      for (TreeNodes_t::iterator it = treeNodes_.begin ();
+	   it != treeNodes_.end (); ++it) {
+	it->generation = labels_.generation ();
+      }
+    }
+
+    void KDTree::build (TreeNodes_t& treeNodes, Points_t& slots,
+			std::size_t index, Points_t::iterator begin,
+			Points_t::iterator end) const
+    {
+      if ((std::size_t) (end - begin) <= bucketSize_) {
+	TreeNode& leaf (treeNodes [index]);
+	leaf.bucket = slots.size ();
+	leaf.size = end - begin;
+	slots.resize (slots.size () + bucketSize_);
+	std::copy (begin, end, slots.begin () + leaf.bucket);
+	for (Points_t::const_iterator itPoint = begin; itPoint != end;
+	     ++itPoint) {
+	  leaf.labels.push_back (pointLabels_ [*itPoint]);
 	}
+	std::sort (leaf.labels.begin (), leaf.labels.end ());
+	leaf.labels.erase (std::unique (leaf.labels.begin (),
+					leaf.labels.end ()),
+			   leaf.labels.end ());
+	return;
       }
+      Points_t::iterator middle = splitPoints (treeNodes [index], begin, end);
+      std::size_t child = treeNodes.size ();
+      treeNodes.resize (child + 2);
+      treeNodes [index].child = child;
+      build (treeNodes, slots, child, begin, middle);
+      build (treeNodes, slots, child + 1, middle, end);
+      unionLabels (treeNodes, index);
+    }
 
-      // Compute median value of coordinates
-      infChild_ = new KDTree (this, splitDim);
-      infChild_->upperBounds_ [splitDim] = (actualUpper [splitDim] +
-					    actualLower [splitDim])/2;
-      supChild_ = new KDTree(this, splitDim);
-      supChild_->lowerBounds_ [splitDim] = (actualUpper [splitDim] +
-					    actualLower [splitDim])/2;
+    void KDTree::buildFragment (Fragment* fragment, Points_t::iterator begin,
+				Points_t::iterator end) const
+    {
+      // Exceptions cannot leave the thread, they are reported by rebuild.
+      try {
+	fragment->treeNodes.assign (1, TreeNode ());
+	build (fragment->treeNodes, fragment->slots, 0, begin, end);
+      } catch (const std::exception& exc) {
+	fragment->error = exc.what ();
+      }
+    }
+
+    void KDTree::splice (std::size_t index, const Fragment& fragment)
+    {
+      // Node i > 0 of the fragment is appended at nodeOffset + i
+      const std::size_t nodeOffset = treeNodes_.size () - 1;
+      const std::size_t slotOffset = slots_.size ();
+      slots_.insert (slots_.end (), fragment.slots.begin (),
+		     fragment.slots.end ());
+      for (std::size_t i = 0; i < fragment.treeNodes.size (); ++i) {
+	TreeNode treeNode (fragment.treeNodes [i]);
+	if (treeNode.child != 0) {
+	  treeNode.child += nodeOffset;
+	} else {
+	  treeNode.bucket += slotOffset;
+	}
+	if (i == 0) {
+	  treeNodes_ [index] = treeNode;
+	} else {
+	  treeNodes_.push_back (treeNode);
+	}
+      }
+    }
+
+    void KDTree::unionLabels (TreeNodes_t& treeNodes, std::size_t index)
+    {
+      const TreeNode& infChild (treeNodes [treeNodes [index].child]);
+      const TreeNode& supChild (treeNodes [treeNodes [index].child + 1]);
+      std::vector <std::size_t> labels;
+      std::set_union (infChild.labels.begin (), infChild.labels.end (),
+		      supChild.labels.begin (), supChild.labels.end (),
+		      std::back_inserter (labels));
+      treeNodes [index].labels.swap (labels);
+    }
+
+    const std::vector <std::size_t>& KDTree::labels (std::size_t index)
+    {
+      TreeNode& treeNode (treeNodes_ [index]);
+      // Some connected components may have been merged since last visit
+      labels_.update (treeNode.labels, treeNode.generation);
+      return treeNode.labels;
     }
 
     // get joints limits
@@ -217,27 +483,8 @@ namespace hpp {
       }
     }
 
-
-    value_type KDTree::distanceToBox (const ConfigurationPtr_t& configuration) {
-      value_type minDistance;
-      value_type DistanceToUpperBound;
-      value_type DistanceToLowerBound;
-      // Projection of the configuration on the box
-      Configuration_t confbox = *configuration;
-
-      DistanceToLowerBound = fabs (lowerBounds_[splitDim_] -
-				   (*configuration) [splitDim_])
-	* weights_ [splitDim_];
-      DistanceToUpperBound = fabs (upperBounds_[splitDim_] -
-				   (*configuration)[splitDim_])
-	* weights_ [splitDim_];
-      minDistance = std::min (DistanceToLowerBound, DistanceToUpperBound);
-      return minDistance;
-    }
-
-    NodePtr_t KDTree::search (const ConfigurationPtr_t& configuration,
-			      const ConnectedComponentPtr_t& connectedComponent,
-                              value_type& minDistance) {
+    void KDTree::checkRootBox (const ConfigurationPtr_t& configuration) const
+    {
       // Test if the configuration is in the root box
       for ( std::size_t i=0 ; i<dim_ ; i++ ) {
 	if ( (*configuration)[i] < lowerBounds_[i] || (*configuration)[i]
@@ -250,86 +497,219 @@ namespace hpp {
 	  throw std::runtime_error (oss.str ());
 	}
       }
-      value_type boxDistance = 0.;
-      NodePtr_t nearest = NULL;
+    }
+
+    NodePtr_t KDTree::search (const ConfigurationPtr_t& configuration,
+			      const ConnectedComponentPtr_t& connectedComponent,
+                              value_type& minDistance) {
+      checkRootBox (configuration);
       minDistance = std::numeric_limits <value_type>::infinity ();
-      this->search (boxDistance, minDistance, configuration,
-		    connectedComponent, nearest);
-      assert (nearest);
-      return nearest;
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return NULL;
+      Candidates_t candidates;
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, label, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      assert (!candidates.empty ());
+      minDistance = candidates.top ().first;
+      return candidates.top ().second;
     }
 
-    void KDTree::search (value_type boxDistance, value_type& minDistance,
-			 const ConfigurationPtr_t& configuration,
-			 const ConnectedComponentPtr_t& connectedComponent,
-			 NodePtr_t& nearest) {
-      if ( boxDistance < minDistance*minDistance
-	   && nodesMap_.count(connectedComponent) > 0 ) {
-	// minDistance^2 because boxDistance is a squared distance
-	if ( infChild_ == NULL || supChild_ == NULL ) {
-	  value_type distance = std::numeric_limits <value_type>::infinity ();
-	  for (Nodes_t::iterator itNode =
-		 nodesMap_[connectedComponent].begin ();
-	       itNode != nodesMap_[connectedComponent].end (); ++itNode) {
-	    distance = (*distance_) (*configuration,
-				     *((*itNode)->configuration ()));
-	    if (distance < minDistance) {
-	      minDistance = distance;
-	      nearest = (*itNode);
-	    }
-	  }
+    NodePtr_t KDTree::search (const ConfigurationPtr_t& configuration,
+			      value_type& minDistance)
+    {
+      checkRootBox (configuration);
+      minDistance = std::numeric_limits <value_type>::infinity ();
+      Candidates_t candidates;
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, noLabel, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      if (candidates.empty ()) return NULL;
+      minDistance = candidates.top ().first;
+      return candidates.top ().second;
+    }
+
+    void KDTree::search (const ConfigurationPtr_t& configuration,
+			 NearestNodes_t& nearest)
+    {
+      checkRootBox (configuration);
+      nearest.clear ();
+      // Nearest node of each connected component indexed by label
+      Nearest_t best (labels_.size (), std::make_pair
+		      (NodePtr_t (NULL),
+		       std::numeric_limits <value_type>::infinity ()));
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, best);
+      for (std::size_t label = 0; label < best.size (); ++label) {
+	if (best [label].first) {
+	  nearest.insert (std::make_pair (labels_.component (label),
+					  best [label]));
 	}
-	else {
-	  // find config to boxes distances
-	  value_type distanceToInfChild;
-	  value_type distanceToSupChild;
-	  if ( boxDistance == 0. ) {
-	    if ( (*configuration) [supChild_->splitDim_]
-		 > supChild_->lowerBounds_[supChild_->splitDim_])  {
-	      distanceToSupChild = 0.;
-	      distanceToInfChild = infChild_->distanceToBox(configuration);
-	    }
-	    else {
-	      distanceToInfChild = 0.;
-	      distanceToSupChild = supChild_->distanceToBox(configuration);
-	    }
-	  }
-	  else {
-	    distanceToInfChild = infChild_->distanceToBox(configuration);
-	    distanceToSupChild = supChild_->distanceToBox(configuration);
-	  }
-	  // search in the children
-	  if ( distanceToInfChild < distanceToSupChild ) {
-	    infChild_->search(boxDistance, minDistance,
-			      configuration, connectedComponent, nearest);
-	    supChild_->search(boxDistance -
-			      distanceToInfChild*distanceToInfChild +
-			      distanceToSupChild*distanceToSupChild,
-			      minDistance, configuration, connectedComponent,
-			      nearest );
+      }
+    }
+
+    Nodes_t KDTree::kNearest (const ConfigurationPtr_t& configuration,
+			      const ConnectedComponentPtr_t& connectedComponent,
+			      const std::size_t k)
+    {
+      checkRootBox (configuration);
+      Candidates_t candidates;
+      std::size_t label;
+      if (k == 0 || !labels_.find (connectedComponent, label)) {
+	return Nodes_t ();
+      }
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, label, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDTree::kNearest (const ConfigurationPtr_t& configuration,
+			      const std::size_t k)
+    {
+      checkRootBox (configuration);
+      if (k == 0) return Nodes_t ();
+      Candidates_t candidates;
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, noLabel, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDTree::withinRadius (const ConfigurationPtr_t& configuration,
+				  const ConnectedComponentPtr_t&
+				  connectedComponent,
+				  const value_type& maxDistance)
+    {
+      checkRootBox (configuration);
+      Candidates_t candidates;
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return Nodes_t ();
+      vector_t offsets (vector_t::Zero (dim_));
+      search (0, 0., offsets, *configuration, label,
+	      std::numeric_limits <std::size_t>::max (), maxDistance,
+	      candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t KDTree::sortedNodes (Candidates_t& candidates)
+    {
+      Nodes_t result;
+      while (!candidates.empty ()) {
+	result.push_front (candidates.top ().second);
+	candidates.pop ();
+      }
+      return result;
+    }
+
+    void KDTree::search (std::size_t index, value_type boxDistance,
+			 vector_t& offsets, const Configuration_t& configuration,
+			 std::size_t label, std::size_t k,
+			 const value_type& maxDistance,
+			 Candidates_t& candidates)
+    {
+      // Distance of the worst candidate that can still be accepted
+      value_type bound = maxDistance;
+      if (candidates.size () == k) bound = candidates.top ().first;
+      // boxDistance is a squared distance
+      if (boxDistance > bound*bound) return;
+      if (label != noLabel) {
+	const std::vector <std::size_t>& subtreeLabels (labels (index));
+	if (!std::binary_search (subtreeLabels.begin (), subtreeLabels.end (),
+				 label)) return;
+      }
+      const TreeNode& treeNode (treeNodes_ [index]);
+      if (treeNode.child == 0) {
+	for (std::size_t slot = treeNode.bucket;
+	     slot < treeNode.bucket + treeNode.size; ++slot) {
+	  std::size_t point = slots_ [slot];
+	  if (label != noLabel && this->label (point) != label) continue;
+	  ConfigurationIn_t q (configurations_->col (point));
+	  // Screen the point with the cheap lower bound of the distance
+	  bound = maxDistance;
+	  if (candidates.size () == k) bound = candidates.top ().first;
+	  if (distance_->lowerBound (configuration, q) > bound) continue;
+	  value_type distance = (*distance_) (configuration, q);
+	  if (distance > maxDistance) continue;
+	  if (candidates.size () < k) {
+	    candidates.push (Candidate_t (distance, points_ [point]));
+	  } else if (distance < candidates.top ().first) {
+	    candidates.pop ();
+	    candidates.push (Candidate_t (distance, points_ [point]));
 	  }
-	  else {
-	    supChild_->search(boxDistance,minDistance,
-			      configuration, connectedComponent, nearest);
-	    infChild_->search(boxDistance -
-			      distanceToSupChild*distanceToSupChild +
-			      distanceToInfChild*distanceToInfChild,
-			      minDistance, configuration, connectedComponent,
-			      nearest);
+	}
+	return;
+      }
+      // Per dimension distances to the box are stored in offsets in order
+      // to update the squared distance to the box of the farthest child.
+      size_type dim = treeNode.splitDim;
+      std::size_t nearChild = treeNode.child;
+      std::size_t farChild = treeNode.child + 1;
+      if (configuration [dim] > treeNode.splitValue) {
+	std::swap (nearChild, farChild);
+      }
+      search (nearChild, boxDistance, offsets, configuration, label, k,
+	      maxDistance, candidates);
+      value_type oldOffset = offsets [dim];
+      value_type newOffset = fabs (configuration [dim] - treeNode.splitValue)
+	* boxWeights_ [dim];
+      offsets [dim] = newOffset;
+      search (farChild, boxDistance - oldOffset*oldOffset +
+	      newOffset*newOffset, offsets, configuration, label, k,
+	      maxDistance, candidates);
+      offsets [dim] = oldOffset;
+    }
+
+    void KDTree::search (std::size_t index, value_type boxDistance,
+			 vector_t& offsets, const Configuration_t& configuration,
+			 Nearest_t& nearest)
+    {
+      // The subtree is explored if it may contain a node closer than the
+      // current nearest node of at least one connected component.
+      const std::vector <std::size_t>& subtreeLabels (labels (index));
+      if (subtreeLabels.empty ()) return;
+      value_type bound = 0;
+      for (std::vector <std::size_t>::const_iterator it =
+	     subtreeLabels.begin (); it != subtreeLabels.end (); ++it) {
+	bound = std::max (bound, nearest [*it].second);
+      }
+      if (boxDistance > bound*bound) return;
+      const TreeNode& treeNode (treeNodes_ [index]);
+      if (treeNode.child == 0) {
+	for (std::size_t slot = treeNode.bucket;
+	     slot < treeNode.bucket + treeNode.size; ++slot) {
+	  std::size_t point = slots_ [slot];
+	  std::pair <NodePtr_t, value_type>& best (nearest [label (point)]);
+	  ConfigurationIn_t q (configurations_->col (point));
+	  if (distance_->lowerBound (configuration, q) > best.second) continue;
+	  value_type distance = (*distance_) (configuration, q);
+	  if (distance < best.second) {
+	    best.first = points_ [point];
+	    best.second = distance;
 	  }
 	}
+	return;
       }
+      size_type dim = treeNode.splitDim;
+      std::size_t nearChild = treeNode.child;
+      std::size_t farChild = treeNode.child + 1;
+      if (configuration [dim] > treeNode.splitValue) {
+	std::swap (nearChild, farChild);
+      }
+      search (nearChild, boxDistance, offsets, configuration, nearest);
+      value_type oldOffset = offsets [dim];
+      value_type newOffset = fabs (configuration [dim] - treeNode.splitValue)
+	* boxWeights_ [dim];
+      offsets [dim] = newOffset;
+      search (farChild, boxDistance - oldOffset*oldOffset +
+	      newOffset*newOffset, offsets, configuration, nearest);
+      offsets [dim] = oldOffset;
     }
 
     void KDTree::merge(ConnectedComponentPtr_t cc1,
 		       ConnectedComponentPtr_t cc2) {
-      nodesMap_[cc1].merge(nodesMap_[cc2]);
-      NodesMap_t::iterator it = nodesMap_.find (cc2);
-      nodesMap_.erase(it);
-      if ( infChild_ != NULL || supChild_ != NULL ) {
-	infChild_->merge(cc1, cc2);
-	supChild_->merge(cc1, cc2);
-      }
+      // Labels of cc2 now resolve to cc1, the tree itself is updated lazily
+      labels_.merge (cc1, cc2);
     }
     } // namespace nearestNeighbor
   } // namespace core
@@ -19,23 +19,33 @@
 #ifndef HPP_CORE_NEAREST_NEIGHBOR_K_D_TREE_HH
 # define HPP_CORE_NEAREST_NEIGHBOR_K_D_TREE_HH
 
+# include <queue>
+# include <string>
+# include <vector>
 # include <hpp/core/distance.hh>
 # include <hpp/core/node.hh>
 # include <hpp/model/joint.hh>
 # include <hpp/model/joint-configuration.hh>
 # include <hpp/model/device.hh>
 # include <hpp/core/nearest-neighbor.hh>
+# include "nearest-neighbor/component-labels.hh"
 
 namespace hpp {
   namespace core {
     namespace nearestNeighbor {
     // Built an k-dimentional tree for the nearest neighbour research
+    //
+    // Tree nodes are stored in a flat array, the children of a tree node
+    // being stored contiguously. Each leaf owns a fixed size range of slots
+    // in a pool of point indices. The connected component of each point is
+    // stored as a label (see ComponentLabels), and each tree node keeps the
+    // sorted list of labels of the points below it in order to skip the
+    // subtrees that do not contain a given connected component.
     class KDTree : public NearestNeighbor
     {
     public:
 
       //constructor
-      KDTree(const KDTreePtr_t mother, size_type splitDim);
       KDTree(const DevicePtr_t& robot, const DistancePtr_t& distance_,
 	     int bucketSize);
 
@@ -48,12 +58,46 @@ namespace hpp {
       // Clear all the nodes in the KDTree
       virtual void clear();
 
+      // build the tree from a set of nodes, splitting at median values
+      virtual void build (const Nodes_t& nodes);
+
+      // set the number of threads used to build the tree (1 by default)
+      void buildThreads (std::size_t threads);
+
+      // the tree is rebuilt when a node is inserted deeper than factor times
+      // the depth of a balanced tree (2 by default). 0 disables rebuilding.
+      void rebuildFactor (value_type factor);
+
       // search nearest node
       virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
 			        const ConnectedComponentPtr_t&
 				connectedComponent,
 				value_type& minDistance);
 
+      // search nearest node in the whole roadmap
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				value_type& minDistance);
+
+      // search nearest node of each connected component
+      virtual void search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest);
+
+      // search the k nearest nodes
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k);
+
+      // search the k nearest nodes in the whole roadmap
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k);
+
+      // search the nodes closer than maxDistance
+      virtual Nodes_t withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance);
+
       // merge two connected components in the whole tree
       void merge(ConnectedComponentPtr_t cc1, ConnectedComponentPtr_t cc2);
       // Get distance function
@@ -61,52 +105,144 @@ namespace hpp {
       {
 	return distance_;
       }
+
+      // weights of the configuration coordinates in the distance to a box,
+      // 0 for coordinates of rotations that are not bounded
+      static vector_t boxWeights (const WeighedDistancePtr_t& distance);
     private:
+      // Node of the tree
+      struct TreeNode
+      {
+	TreeNode () : splitDim (0), splitValue (0), child (0), bucket (0),
+		      size (0), generation (0), labels ()
+	{
+	}
+	// splitting dimention and value, meaningless for leaves
+	size_type splitDim;
+	value_type splitValue;
+	// index of the inferior child, the superior child follows it.
+	// 0 for leaves since the root is never a child.
+	std::size_t child;
+	// first slot of the bucket and number of points, for leaves only
+	std::size_t bucket;
+	std::size_t size;
+	// labels generation the labels below were computed with
+	std::size_t generation;
+	// sorted representative labels of the points below the tree node
+	std::vector <std::size_t> labels;
+      }; // struct TreeNode
+      typedef std::vector <TreeNode> TreeNodes_t;
+      typedef std::vector <std::size_t> Points_t;
+
+      // Tree nodes and buckets of a subtree built by a thread
+      struct Fragment
+      {
+	TreeNodes_t treeNodes;
+	Points_t slots;
+	std::string error;
+      }; // struct Fragment
+      // root of a subtree to build and points it contains
+      typedef std::pair <std::size_t, std::pair <Points_t::iterator,
+						 Points_t::iterator> > Task_t;
+
       DevicePtr_t robot_;
       std::size_t dim_;
 
       WeighedDistancePtr_t distance_;
-      vector_t weights_;
-      typedef std::map <ConnectedComponentPtr_t, Nodes_t> NodesMap_t;
-      NodesMap_t nodesMap_;
       std::size_t bucketSize_;
-      std::size_t bucket_;
+      std::size_t threads_;
+      value_type rebuildFactor_;
 
-      // number of the splited dimention
-      std::size_t splitDim_;
+      // bounds of the root box
       vector_t upperBounds_;
       vector_t lowerBounds_;
 
-      // type of each dimention
-      //	0 => bounded dimention
-      //	1 => looped dimention
-      //	2 => quaternion
-      vector_t typeDims_;
-
-      KDTreePtr_t supChild_;
-      KDTreePtr_t infChild_;
-
-      // Split the node into two subnodes
-      void split();
-
-      // find the leaf of the KDtree for the configuration/node.
-      // starts the research at KDTree then go down the tree.
-      // also add connectedComopnent of node along the path from tree
-      // root to tree leaf
-      KDTreePtr_t findLeaf(const NodePtr_t& node);
+      // weights of the coordinates in the distance to a box, 0 for
+      // dimentions that are not bounded
+      vector_t boxWeights_;
+
+      // tree nodes, the root is the first one
+      TreeNodes_t treeNodes_;
+      // indices of the points stored in the leaves
+      Points_t slots_;
+      // nodes and labels of the points
+      // points_ [i] is the node of index i, its configuration is column i
+      // of configurations_.
+      std::vector <NodePtr_t> points_;
+      Points_t pointLabels_;
+      ComponentLabels labels_;
+      // number of nodes inserted since the tree was last built
+      std::size_t insertions_;
+
+      // Split a leaf into two leaves
+      void split (std::size_t leaf);
+
+      // Choose the splitting dimention and value of a tree node and
+      // partition the points accordingly.
+      // return the first point of the superior child.
+      Points_t::iterator splitPoints (TreeNode& treeNode,
+				      Points_t::iterator begin,
+				      Points_t::iterator end) const;
+
+      // Rebuild the tree from the points already stored
+      void rebuild ();
+
+      // Build the subtree rooted at treeNodes [index] containing the points
+      // between begin and end.
+      void build (TreeNodes_t& treeNodes, Points_t& slots, std::size_t index,
+		  Points_t::iterator begin, Points_t::iterator end) const;
+
+      // Build a subtree in a fragment
+      void buildFragment (Fragment* fragment, Points_t::iterator begin,
+			  Points_t::iterator end) const;
+
+      // Move a fragment in the tree, the root of the fragment replacing
+      // treeNodes_ [index]
+      void splice (std::size_t index, const Fragment& fragment);
+
+      // set labels of an inner node from the labels of its children
+      static void unionLabels (TreeNodes_t& treeNodes, std::size_t index);
 
       // find bounds on each dimention
       void findDeviceBounds();
 
-      // distance to the nearest bound on the splited dimention
-      value_type distanceToBox(const ConfigurationPtr_t& configuration);
+      // update labels of a tree node after connected components merged
+      const std::vector <std::size_t>& labels (std::size_t treeNode);
 
-      // search nearest node
-      void search(value_type boxDistance, value_type& minDistance,
-		  const ConfigurationPtr_t& configuration,
-		  const ConnectedComponentPtr_t& connectedComponent,
-		  NodePtr_t& nearest);
+      // store a node as a new point, return the index of the point
+      std::size_t addPoint (const NodePtr_t& node);
+
+      // representative label of a point
+      std::size_t label (std::size_t point)
+      {
+	return pointLabels_ [point] = labels_.find (pointLabels_ [point]);
+      }
 
+      // Max-heap of the best candidates found so far
+      typedef std::pair <value_type, NodePtr_t> Candidate_t;
+      typedef std::priority_queue <Candidate_t> Candidates_t;
+
+      // search at most k nodes closer than maxDistance, in the connected
+      // component of the given label, or in the whole roadmap if the label
+      // is not a valid label.
+      void search (std::size_t treeNode, value_type boxDistance,
+		   vector_t& offsets, const Configuration_t& configuration,
+		   std::size_t label, std::size_t k,
+		   const value_type& maxDistance, Candidates_t& candidates);
+
+      // search nearest node of each connected component, subtrees are
+      // pruned with respect to the worst distance among the connected
+      // components they contain.
+      typedef std::vector <std::pair <NodePtr_t, value_type> > Nearest_t;
+      void search (std::size_t treeNode, value_type boxDistance,
+		   vector_t& offsets, const Configuration_t& configuration,
+		   Nearest_t& nearest);
+
+      // check that the configuration lies in the root box
+      void checkRootBox (const ConfigurationPtr_t& configuration) const;
+
+      // pop candidates into a list sorted by increasing distance
+      static Nodes_t sortedNodes (Candidates_t& candidates);
 
     }; // class KDTree
     } // namespace nearestNeighbor
@@ -0,0 +1,453 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <hpp/util/debug.hh>
+#include "nearest-neighbor/vp-tree.hh"
+
+namespace hpp {
+  namespace core {
+    namespace nearestNeighbor {
+    namespace {
+      // label meaning "any connected component"
+      const std::size_t noLabel = std::numeric_limits <std::size_t>::max ();
+
+      bool lessDistance (const std::pair <value_type, std::size_t>& d1,
+			 const std::pair <value_type, std::size_t>& d2)
+      {
+	return d1.first < d2.first;
+      }
+
+      // Whether a point is inside a ball
+      struct NotGreater
+      {
+	NotGreater (value_type radius) : radius_ (radius)
+	{
+	}
+	bool operator () (const std::pair <value_type, std::size_t>& d) const
+	{
+	  return !(d.first > radius_);
+	}
+	value_type radius_;
+      }; // struct NotGreater
+    } // namespace
+
+    VPTree::VPTree (const DistancePtr_t& distance, std::size_t bucketSize) :
+      distance_ (distance), bucketSize_ (bucketSize), treeNodes_ (),
+      slots_ (), points_ (), pointLabels_ (), labels_ ()
+    {
+      assert (bucketSize_ > 1);
+      clear ();
+    }
+
+    VPTree::~VPTree ()
+    {
+    }
+
+    void VPTree::clear ()
+    {
+      treeNodes_.assign (1, TreeNode ());
+      slots_.assign (bucketSize_, 0);
+      points_.clear ();
+      pointLabels_.clear ();
+      labels_.clear ();
+    }
+
+    void VPTree::addNode (const NodePtr_t& node)
+    {
+      const Configuration_t& q (*(node->configuration ()));
+      std::size_t point = addPoint (node);
+      std::size_t label = pointLabels_ [point];
+      // Go down the tree, register the label and update distance ranges
+      // along the path
+      std::size_t current = 0;
+      while (true) {
+	labels (current);
+	ComponentLabels::insert (treeNodes_ [current].labels, label);
+	TreeNode& treeNode (treeNodes_ [current]);
+	if (treeNode.child != 0) {
+	  value_type d = distance (q, treeNode.vantagePoint);
+	  current = treeNode.child;
+	  if (d > treeNode.radius) ++current;
+	  TreeNode& child (treeNodes_ [current]);
+	  child.lower = std::min (child.lower, d);
+	  child.upper = std::max (child.upper, d);
+	}
+	else if (treeNode.size < bucketSize_) {
+	  slots_ [treeNode.bucket + treeNode.size] = point;
+	  ++treeNode.size;
+	  return;
+	}
+	else {
+	  // the leaf becomes an inner node, go on from it.
+	  split (current);
+	}
+      }
+    }
+
+    void VPTree::build (const Nodes_t& nodes)
+    {
+      clear ();
+      Distances_t points;
+      points.reserve (nodes.size ());
+      for (Nodes_t::const_iterator itNode = nodes.begin ();
+	   itNode != nodes.end (); ++itNode) {
+	points.push_back (Distance_t (0, addPoint (*itNode)));
+      }
+      slots_.clear ();
+      build (0, points.begin (), points.end ());
+      for (TreeNodes_t::iterator it = treeNodes_.begin ();
+	   it != treeNodes_.end (); ++it) {
+	it->generation = labels_.generation ();
+      }
+    }
+
+    std::size_t VPTree::addPoint (const NodePtr_t& node)
+    {
+      // Point i is column i of the configurations of the roadmap
+      assert (configurations_);
+      assert (node->index () == points_.size ());
+      std::size_t point = points_.size ();
+      points_.push_back (node);
+      pointLabels_.push_back (labels_.label (node->connectedComponent ()));
+      return point;
+    }
+
+    VPTree::Distances_t::iterator VPTree::splitPoints
+    (std::size_t index, Distances_t::iterator begin, Distances_t::iterator end)
+    {
+      // The vantage point is the point farthest from the first point, which
+      // tends to lie on the border of the set.
+      ConfigurationIn_t first (configurations_->col (begin->second));
+      Distances_t::iterator farthest = begin;
+      for (Distances_t::iterator it = begin; it != end; ++it) {
+	it->first = distance (first, it->second);
+	if (it->first > farthest->first) farthest = it;
+      }
+      const std::size_t vantagePoint = farthest->second;
+      ConfigurationIn_t vp (configurations_->col (vantagePoint));
+      value_type maxDistance = 0;
+      for (Distances_t::iterator it = begin; it != end; ++it) {
+	it->first = distance (vp, it->second);
+	maxDistance = std::max (maxDistance, it->first);
+      }
+      if (maxDistance <= 0) {
+	throw std::runtime_error
+	  ("Attempt to split a VPTree bucket of identical configurations");
+      }
+      // Split at the median distance. If the median is the maximal
+      // distance, split below it so that both children are not empty.
+      Distances_t::iterator median = begin + (end - begin - 1)/2;
+      std::nth_element (begin, median, end, lessDistance);
+      value_type radius = median->first;
+      if (radius == maxDistance) {
+	radius = 0;
+	for (Distances_t::const_iterator it = begin; it != end; ++it) {
+	  if (it->first < maxDistance && it->first > radius) {
+	    radius = it->first;
+	  }
+	}
+      }
+      Distances_t::iterator middle = std::partition (begin, end,
+						     NotGreater (radius));
+      const std::size_t child = treeNodes_.size ();
+      treeNodes_.resize (child + 2);
+      TreeNode& parent (treeNodes_ [index]);
+      parent.vantagePoint = vantagePoint;
+      parent.radius = radius;
+      parent.child = child;
+      TreeNode& inside (treeNodes_ [child]);
+      TreeNode& outside (treeNodes_ [child + 1]);
+      inside.lower = std::min_element (begin, middle, lessDistance)->first;
+      inside.upper = std::max_element (begin, middle, lessDistance)->first;
+      outside.lower = std::min_element (middle, end, lessDistance)->first;
+      outside.upper = std::max_element (middle, end, lessDistance)->first;
+      return middle;
+    }
+
+    void VPTree::split (std::size_t leaf)
+    {
+      const std::size_t bucket = treeNodes_ [leaf].bucket;
+      const std::size_t size = treeNodes_ [leaf].size;
+      Distances_t points;
+      points.reserve (size);
+      for (std::size_t slot = bucket; slot < bucket + size; ++slot) {
+	points.push_back (Distance_t (0, slots_ [slot]));
+      }
+      Distances_t::iterator middle = splitPoints (leaf, points.begin (),
+						  points.end ());
+      // The inside child keeps the bucket of the leaf, a new bucket is
+      // allocated for the outside child.
+      TreeNode& parent (treeNodes_ [leaf]);
+      parent.size = 0;
+      TreeNode& inside (treeNodes_ [parent.child]);
+      TreeNode& outside (treeNodes_ [parent.child + 1]);
+      inside.bucket = bucket;
+      outside.bucket = slots_.size ();
+      inside.generation = outside.generation = labels_.generation ();
+      slots_.resize (slots_.size () + bucketSize_);
+      for (Distances_t::const_iterator it = points.begin ();
+	   it != points.end (); ++it) {
+	TreeNode& treeNode (it < middle ? inside : outside);
+	slots_ [treeNode.bucket + treeNode.size] = it->second;
+	++treeNode.size;
+	ComponentLabels::insert (treeNode.labels, label (it->second));
+      }
+    }
+
+    void VPTree::build (std::size_t index, Distances_t::iterator begin,
+			Distances_t::iterator end)
+    {
+      if ((std::size_t) (end - begin) <= bucketSize_) {
+	TreeNode& leaf (treeNodes_ [index]);
+	leaf.bucket = slots_.size ();
+	leaf.size = end - begin;
+	slots_.resize (slots_.size () + bucketSize_);
+	std::size_t slot = leaf.bucket;
+	for (Distances_t::const_iterator it = begin; it != end; ++it) {
+	  slots_ [slot++] = it->second;
+	  ComponentLabels::insert (leaf.labels, label (it->second));
+	}
+	return;
+      }
+      Distances_t::iterator middle = splitPoints (index, begin, end);
+      const std::size_t child = treeNodes_ [index].child;
+      build (child, begin, middle);
+      build (child + 1, middle, end);
+      const TreeNode& inside (treeNodes_ [child]);
+      const TreeNode& outside (treeNodes_ [child + 1]);
+      std::vector <std::size_t> labels;
+      std::set_union (inside.labels.begin (), inside.labels.end (),
+		      outside.labels.begin (), outside.labels.end (),
+		      std::back_inserter (labels));
+      treeNodes_ [index].labels.swap (labels);
+    }
+
+    NodePtr_t VPTree::search (const ConfigurationPtr_t& configuration,
+			      const ConnectedComponentPtr_t&
+			      connectedComponent, value_type& distance)
+    {
+      distance = std::numeric_limits <value_type>::infinity ();
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return NULL;
+      Candidates_t candidates;
+      search (0, 0, *configuration, label, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      assert (!candidates.empty ());
+      distance = candidates.top ().first;
+      return candidates.top ().second;
+    }
+
+    NodePtr_t VPTree::search (const ConfigurationPtr_t& configuration,
+			      value_type& distance)
+    {
+      distance = std::numeric_limits <value_type>::infinity ();
+      Candidates_t candidates;
+      search (0, 0, *configuration, noLabel, 1,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      if (candidates.empty ()) return NULL;
+      distance = candidates.top ().first;
+      return candidates.top ().second;
+    }
+
+    void VPTree::search (const ConfigurationPtr_t& configuration,
+			 NearestNodes_t& nearest)
+    {
+      nearest.clear ();
+      // Nearest node of each connected component indexed by label
+      Nearest_t best (labels_.size (), std::make_pair
+		      (NodePtr_t (NULL),
+		       std::numeric_limits <value_type>::infinity ()));
+      search (0, 0, *configuration, best);
+      for (std::size_t label = 0; label < best.size (); ++label) {
+	if (best [label].first) {
+	  nearest.insert (std::make_pair (labels_.component (label),
+					  best [label]));
+	}
+      }
+    }
+
+    Nodes_t VPTree::kNearest (const ConfigurationPtr_t& configuration,
+			      const ConnectedComponentPtr_t&
+			      connectedComponent, const std::size_t k)
+    {
+      Candidates_t candidates;
+      std::size_t label;
+      if (k == 0 || !labels_.find (connectedComponent, label)) {
+	return Nodes_t ();
+      }
+      search (0, 0, *configuration, label, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t VPTree::kNearest (const ConfigurationPtr_t& configuration,
+			      const std::size_t k)
+    {
+      if (k == 0) return Nodes_t ();
+      Candidates_t candidates;
+      search (0, 0, *configuration, noLabel, k,
+	      std::numeric_limits <value_type>::infinity (), candidates);
+      return sortedNodes (candidates);
+    }
+
+    Nodes_t VPTree::withinRadius (const ConfigurationPtr_t& configuration,
+				  const ConnectedComponentPtr_t&
+				  connectedComponent,
+				  const value_type& maxDistance)
+    {
+      Candidates_t candidates;
+      std::size_t label;
+      if (!labels_.find (connectedComponent, label)) return Nodes_t ();
+      search (0, 0, *configuration, label,
+	      std::numeric_limits <std::size_t>::max (), maxDistance,
+	      candidates);
+      return sortedNodes (candidates);
+    }
+
+    void VPTree::merge (ConnectedComponentPtr_t cc1,
+			ConnectedComponentPtr_t cc2)
+    {
+      // Labels of cc2 now resolve to cc1, the tree itself is updated lazily
+      labels_.merge (cc1, cc2);
+    }
+
+    void VPTree::childBounds (const TreeNode& treeNode, value_type distance,
+			      value_type lowerBound, value_type& insideBound,
+			      value_type& outsideBound) const
+    {
+      // By the triangle inequality, the distance between the configuration
+      // and a point at distance r from the vantage point is not less than
+      // |distance - r|.
+      const TreeNode& inside (treeNodes_ [treeNode.child]);
+      const TreeNode& outside (treeNodes_ [treeNode.child + 1]);
+      insideBound = std::max (lowerBound, std::max (inside.lower - distance,
+						    distance - inside.upper));
+      outsideBound = std::max (lowerBound,
+			       std::max (outside.lower - distance,
+					 distance - outside.upper));
+    }
+
+    void VPTree::search (std::size_t index, value_type lowerBound,
+			 const Configuration_t& configuration,
+			 std::size_t label, std::size_t k,
+			 const value_type& maxDistance,
+			 Candidates_t& candidates)
+    {
+      // Distance of the worst candidate that can still be accepted
+      value_type bound = maxDistance;
+      if (candidates.size () == k) bound = candidates.top ().first;
+      if (lowerBound > bound) return;
+      if (label != noLabel) {
+	const std::vector <std::size_t>& subtreeLabels (labels (index));
+	if (!std::binary_search (subtreeLabels.begin (), subtreeLabels.end (),
+				 label)) return;
+      }
+      const TreeNode& treeNode (treeNodes_ [index]);
+      if (treeNode.child == 0) {
+	for (std::size_t slot = treeNode.bucket;
+	     slot < treeNode.bucket + treeNode.size; ++slot) {
+	  std::size_t point = slots_ [slot];
+	  if (label != noLabel && this->label (point) != label) continue;
+	  // Screen the point with the cheap lower bound of the distance
+	  bound = maxDistance;
+	  if (candidates.size () == k) bound = candidates.top ().first;
+	  if (this->lowerBound (configuration, point) > bound) continue;
+	  value_type d = distance (configuration, point);
+	  if (d > maxDistance) continue;
+	  if (candidates.size () < k) {
+	    candidates.push (Candidate_t (d, points_ [point]));
+	  } else if (d < candidates.top ().first) {
+	    candidates.pop ();
+	    candidates.push (Candidate_t (d, points_ [point]));
+	  }
+	}
+	return;
+      }
+      value_type d = distance (configuration, treeNode.vantagePoint);
+      value_type insideBound, outsideBound;
+      childBounds (treeNode, d, lowerBound, insideBound, outsideBound);
+      if (insideBound <= outsideBound) {
+	search (treeNode.child, insideBound, configuration, label, k,
+		maxDistance, candidates);
+	search (treeNode.child + 1, outsideBound, configuration, label, k,
+		maxDistance, candidates);
+      } else {
+	search (treeNode.child + 1, outsideBound, configuration, label, k,
+		maxDistance, candidates);
+	search (treeNode.child, insideBound, configuration, label, k,
+		maxDistance, candidates);
+      }
+    }
+
+    void VPTree::search (std::size_t index, value_type lowerBound,
+			 const Configuration_t& configuration,
+			 Nearest_t& nearest)
+    {
+      // The subtree is explored if it may contain a node closer than the
+      // current nearest node of at least one connected component.
+      const std::vector <std::size_t>& subtreeLabels (labels (index));
+      if (subtreeLabels.empty ()) return;
+      value_type bound = 0;
+      for (std::vector <std::size_t>::const_iterator it =
+	     subtreeLabels.begin (); it != subtreeLabels.end (); ++it) {
+	bound = std::max (bound, nearest [*it].second);
+      }
+      if (lowerBound > bound) return;
+      const TreeNode& treeNode (treeNodes_ [index]);
+      if (treeNode.child == 0) {
+	for (std::size_t slot = treeNode.bucket;
+	     slot < treeNode.bucket + treeNode.size; ++slot) {
+	  std::size_t point = slots_ [slot];
+	  std::pair <NodePtr_t, value_type>& best (nearest [label (point)]);
+	  if (this->lowerBound (configuration, point) > best.second) continue;
+	  value_type d = distance (configuration, point);
+	  if (d < best.second) {
+	    best.first = points_ [point];
+	    best.second = d;
+	  }
+	}
+	return;
+      }
+      value_type d = distance (configuration, treeNode.vantagePoint);
+      value_type insideBound, outsideBound;
+      childBounds (treeNode, d, lowerBound, insideBound, outsideBound);
+      if (insideBound <= outsideBound) {
+	search (treeNode.child, insideBound, configuration, nearest);
+	search (treeNode.child + 1, outsideBound, configuration, nearest);
+      } else {
+	search (treeNode.child + 1, outsideBound, configuration, nearest);
+	search (treeNode.child, insideBound, configuration, nearest);
+      }
+    }
+
+    Nodes_t VPTree::sortedNodes (Candidates_t& candidates)
+    {
+      Nodes_t result;
+      while (!candidates.empty ()) {
+	result.push_front (candidates.top ().second);
+	candidates.pop ();
+      }
+      return result;
+    }
+    } // namespace nearestNeighbor
+  } // namespace core
+} // namespace hpp
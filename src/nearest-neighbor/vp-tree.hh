@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_NEAREST_NEIGHBOR_VP_TREE_HH
+# define HPP_CORE_NEAREST_NEIGHBOR_VP_TREE_HH
+
+# include <queue>
+# include <vector>
+# include <hpp/core/distance.hh>
+# include <hpp/core/node.hh>
+# include <hpp/core/nearest-neighbor.hh>
+# include "nearest-neighbor/component-labels.hh"
+
+namespace hpp {
+  namespace core {
+    namespace nearestNeighbor {
+    // Vantage point tree for the nearest neighbour research
+    //
+    // Each inner node of the tree stores a vantage point and a radius. The
+    // points closer to the vantage point than the radius are stored in the
+    // inside child, the other ones in the outside child. Each child stores
+    // the range of the distances of its points to the vantage point of
+    // its parent, so that subtrees are pruned by the triangle inequality.
+    //
+    // Unlike KDTree, the tree only relies on the distance. Pruning is thus
+    // exact for any metric, including the weighed distance between
+    // configurations of robots with rotation or free-flying joints.
+    //
+    // Layout and connected components are handled as in KDTree.
+    class VPTree : public NearestNeighbor
+    {
+    public:
+      // constructor
+      VPTree (const DistancePtr_t& distance, std::size_t bucketSize);
+
+      virtual ~VPTree ();
+
+      virtual void clear ();
+
+      virtual void addNode (const NodePtr_t& node);
+
+      virtual void build (const Nodes_t& nodes);
+
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				value_type& distance);
+
+      virtual NodePtr_t search (const ConfigurationPtr_t& configuration,
+				value_type& distance);
+
+      virtual void search (const ConfigurationPtr_t& configuration,
+			   NearestNodes_t& nearest);
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const ConnectedComponentPtr_t&
+				connectedComponent,
+				const std::size_t k);
+
+      virtual Nodes_t kNearest (const ConfigurationPtr_t& configuration,
+				const std::size_t k);
+
+      virtual Nodes_t withinRadius (const ConfigurationPtr_t& configuration,
+				    const ConnectedComponentPtr_t&
+				    connectedComponent,
+				    const value_type& maxDistance);
+
+      virtual void merge (ConnectedComponentPtr_t cc1,
+			  ConnectedComponentPtr_t cc2);
+
+      virtual DistancePtr_t distance () const
+      {
+	return distance_;
+      }
+
+    private:
+      // Node of the tree
+      struct TreeNode
+      {
+	TreeNode () : vantagePoint (0), radius (0), lower (0), upper (0),
+		      child (0), bucket (0), size (0), generation (0),
+		      labels ()
+	{
+	}
+	// vantage point and radius, meaningless for leaves
+	std::size_t vantagePoint;
+	value_type radius;
+	// range of the distances of the points below to the vantage point of
+	// the parent, meaningless for the root
+	value_type lower;
+	value_type upper;
+	// index of the inside child, the outside child follows it.
+	// 0 for leaves since the root is never a child.
+	std::size_t child;
+	// first slot of the bucket and number of points, for leaves only
+	std::size_t bucket;
+	std::size_t size;
+	// labels generation the labels below were computed with
+	std::size_t generation;
+	// sorted representative labels of the points below the tree node
+	std::vector <std::size_t> labels;
+      }; // struct TreeNode
+      typedef std::vector <TreeNode> TreeNodes_t;
+      typedef std::vector <std::size_t> Points_t;
+      // distance to the vantage point and point
+      typedef std::pair <value_type, std::size_t> Distance_t;
+      typedef std::vector <Distance_t> Distances_t;
+
+      DistancePtr_t distance_;
+      std::size_t bucketSize_;
+      TreeNodes_t treeNodes_;
+      Points_t slots_;
+      // points_ [i] is the node of index i, its configuration is column i
+      // of configurations_.
+      std::vector <NodePtr_t> points_;
+      Points_t pointLabels_;
+      ComponentLabels labels_;
+
+      // distance between a configuration and a point
+      value_type distance (ConfigurationIn_t configuration,
+			   std::size_t point) const
+      {
+	return (*distance_) (configuration, configurations_->col (point));
+      }
+
+      // cheap lower bound of the distance between a configuration and a
+      // point
+      value_type lowerBound (ConfigurationIn_t configuration,
+			     std::size_t point) const
+      {
+	return distance_->lowerBound (configuration,
+				      configurations_->col (point));
+      }
+
+      // store a node as a new point, return the index of the point
+      std::size_t addPoint (const NodePtr_t& node);
+
+      // representative label of a point
+      std::size_t label (std::size_t point)
+      {
+	return pointLabels_ [point] = labels_.find (pointLabels_ [point]);
+      }
+
+      // update labels of a tree node after connected components merged
+      const std::vector <std::size_t>& labels (std::size_t index)
+      {
+	TreeNode& treeNode (treeNodes_ [index]);
+	labels_.update (treeNode.labels, treeNode.generation);
+	return treeNode.labels;
+      }
+
+      // Choose the vantage point and radius of a tree node, partition the
+      // points, the inside points being first, and create the children.
+      // return the first outside point.
+      Distances_t::iterator splitPoints (std::size_t index,
+					 Distances_t::iterator begin,
+					 Distances_t::iterator end);
+
+      // Split a full leaf into two leaves
+      void split (std::size_t leaf);
+
+      // Build the subtree rooted at treeNodes_ [index]
+      void build (std::size_t index, Distances_t::iterator begin,
+		  Distances_t::iterator end);
+
+      // Max-heap of the best candidates found so far
+      typedef std::pair <value_type, NodePtr_t> Candidate_t;
+      typedef std::priority_queue <Candidate_t> Candidates_t;
+
+      // search at most k nodes closer than maxDistance, in the connected
+      // component of the given label, or in the whole roadmap if the label
+      // is not a valid label.
+      // lowerBound is a lower bound of the distance between the
+      // configuration and the points of the subtree.
+      void search (std::size_t index, value_type lowerBound,
+		   const Configuration_t& configuration, std::size_t label,
+		   std::size_t k, const value_type& maxDistance,
+		   Candidates_t& candidates);
+
+      // search nearest node of each connected component
+      typedef std::vector <std::pair <NodePtr_t, value_type> > Nearest_t;
+      void search (std::size_t index, value_type lowerBound,
+		   const Configuration_t& configuration, Nearest_t& nearest);
+
+      // lower bounds of the distance to the points of both children of an
+      // inner node, given the distance to the vantage point.
+      void childBounds (const TreeNode& treeNode, value_type distance,
+			value_type lowerBound, value_type& insideBound,
+			value_type& outsideBound) const;
+
+      // pop candidates into a list sorted by increasing distance
+      static Nodes_t sortedNodes (Candidates_t& candidates);
+    }; // class VPTree
+    } // namespace nearestNeighbor
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_NEAREST_NEIGHBOR_VP_TREE_HH
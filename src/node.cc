@@ -29,14 +29,16 @@ namespace hpp {
 
     Node::Node (const ConfigurationPtr_t& configuration) :
       configuration_ (configuration),
-      connectedComponent_ (ConnectedComponent::create ())
+      connectedComponent_ (ConnectedComponent::create ()), index_ (0),
+      isGoal_ (false)
     {
     }
 
     Node::Node (const ConfigurationPtr_t& configuration,
 		ConnectedComponentPtr_t connectedComponent) :
       configuration_ (configuration),
-      connectedComponent_ (connectedComponent)
+      connectedComponent_ (connectedComponent), index_ (0),
+      isGoal_ (false)
     {
       assert (connectedComponent_);
     }
@@ -86,6 +88,9 @@ namespace hpp {
 
     ConnectedComponentPtr_t Node::connectedComponent () const
     {
+      if (connectedComponent_->merged ()) {
+	connectedComponent_ = connectedComponent_->representative ();
+      }
       return connectedComponent_;
     }
 
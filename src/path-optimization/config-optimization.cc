@@ -88,7 +88,8 @@ namespace hpp {
         hppDout (info, "ConfigOptimization: length " << length);
         value_type alpha = parameters.alphaInit;
         // Loop over pass index.
-        for (std::size_t ipass = 0; ipass < parameters.numberOfPass; ++ipass) {
+        for (std::size_t ipass = 0;
+            ipass < parameters.numberOfPass && !stop (); ++ipass) {
           PathVectorPtr_t optedF = PathVector::create (path->outputSize(),
               path->outputDerivativeSize ());
           PathVectorPtr_t optedB = PathVector::create (path->outputSize(),
@@ -384,7 +384,7 @@ namespace hpp {
 	    }
             HPP_STOP_TIMECOUNTER(GBO_oneStep);
             HPP_DISPLAY_TIMECOUNTER(GBO_oneStep);
-	  } while (!(noCollision && minimumReached) && (!interrupt_));
+	  } while (!(noCollision && minimumReached) && (!stop ()));
 	} // while (!minimumReached)
 	return path0;
       }
@@ -28,6 +28,7 @@
 #include <hpp/core/path-validation.hh>
 #include <hpp/core/path-vector.hh>
 #include <hpp/core/problem.hh>
+#include <hpp/core/random-engine.hh>
 #include <hpp/core/config-projector.hh>
 #include <hpp/core/locked-joint.hh>
 
@@ -226,14 +227,15 @@ namespace hpp {
         std::size_t nbFail = 0;
         std::size_t iJ = 0;
         Configuration_t q1 (pv->outputSize ()), q2 (pv->outputSize ());
-        while (nbFail < maxFailure) {
+        RandomEngine& engine (*problem ().randomEngine ());
+        while (nbFail < maxFailure && !stop ()) {
           iJ %= jv.size();
           JointPtr_t joint = jv[iJ];
           ++iJ;
 
           t3 = current->timeRange ().second;
-          value_type u2 = t3 * rand ()/RAND_MAX;
-          value_type u1 = t3 * rand ()/RAND_MAX;
+          value_type u2 = t3 * engine.uniform ();
+          value_type u1 = t3 * engine.uniform ();
 
           value_type t1, t2;
           if (u1 < u2) {t1 = u1; t2 = u2;} else {t1 = u2; t2 = u1;}
@@ -14,6 +14,7 @@
 // received a copy of the GNU Lesser General Public License along with
 // hpp-core. If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <hpp/core/path-optimizer.hh>
 
 #include <hpp/core/problem.hh>
@@ -34,6 +35,23 @@ namespace hpp {
       }
       return PathPtr_t ();
     }
+
+    void PathOptimizer::maxTime (value_type maxTime)
+    {
+      maxTime_ = maxTime;
+      start_ = boost::posix_time::microsec_clock::universal_time ();
+    }
+
+    bool PathOptimizer::stop () const
+    {
+      if (interrupt_) return true;
+      if (maxTime_ == std::numeric_limits <value_type>::infinity ()) {
+	return false;
+      }
+      boost::posix_time::time_duration elapsed
+	(boost::posix_time::microsec_clock::universal_time () - start_);
+      return 1e-6 * (value_type) elapsed.total_microseconds () >= maxTime_;
+    }
   } // namespace core
 } // namespace hpp
 
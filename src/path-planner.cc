@@ -16,6 +16,10 @@
 // hpp-core  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 # include <hpp/util/debug.hh>
 #include <hpp/core/path-planner.hh>
 #include <hpp/core/roadmap.hh>
@@ -73,8 +77,29 @@ namespace hpp {
       }
     }
 
+    namespace {
+      value_type secondsSince (const boost::posix_time::ptime& start)
+      {
+	boost::posix_time::time_duration elapsed
+	  (boost::posix_time::microsec_clock::universal_time () - start);
+	return 1e-6 * (value_type) elapsed.total_microseconds ();
+      }
+    } // namespace
+
     PathVectorPtr_t PathPlanner::solve ()
     {
+      return solve (std::numeric_limits <value_type>::infinity (),
+		    std::numeric_limits <std::size_t>::max ());
+    }
+
+    PathVectorPtr_t PathPlanner::solve (value_type maxTime,
+					std::size_t maxIterations)
+    {
+      const boost::posix_time::ptime start
+	(boost::posix_time::microsec_clock::universal_time ());
+      const bool bounded =
+	(maxTime != std::numeric_limits <value_type>::infinity ()) ||
+	(maxIterations != std::numeric_limits <std::size_t>::max ());
       interrupt_ = false;
       bool solved = false;
       startSolve ();
@@ -83,14 +108,33 @@ namespace hpp {
       if (solved ) {
 	hppDout (info, "tryDirectPath succeeded");
       }
-      if (interrupt_) throw std::runtime_error ("Interruption");
-      while (!solved) {
+      if (interrupt_ && !solved) throw std::runtime_error ("Interruption");
+      std::size_t iteration = 0;
+      // Anytime planners keep improving the solution until the budget is
+      // exhausted. Once a path is found, an interruption returns it.
+      while (!interrupt_ && (!solved || (bounded && anytime ()))) {
+	if (iteration >= maxIterations || secondsSince (start) >= maxTime) {
+	  break;
+	}
 	oneStep ();
+	++iteration;
 	solved = roadmap_->pathExists ();
-	if (interrupt_) throw std::runtime_error ("Interruption");
+	if (interrupt_ && !solved) {
+	  throw std::runtime_error ("Interruption");
+	}
+      }
+      if (!solved) {
+	std::ostringstream oss;
+	oss << "No path found after " << iteration << " iterations and "
+	    << secondsSince (start) << " seconds: the roadmap contains "
+	    << roadmap_->nodes ().size () << " nodes, "
+	    << roadmap_->edges ().size () << " edges and "
+	    << roadmap_->connectedComponents ().size ()
+	    << " connected components.";
+	throw std::runtime_error (oss.str ().c_str ());
       }
       PathVectorPtr_t planned =  computePath ();
-      return finishSolve (planned);
+      return finishSolve (planned, maxTime - secondsSince (start));
     }
 
     void PathPlanner::interrupt ()
@@ -109,6 +153,12 @@ namespace hpp {
       return path;
     }
 
+    PathVectorPtr_t PathPlanner::finishSolve (const PathVectorPtr_t& path,
+					      value_type)
+    {
+      return finishSolve (path);
+    }
+
     void PathPlanner::tryDirectPath ()
     {
       // call steering method here to build a direct conexion
@@ -18,15 +18,18 @@
 
 #include <hpp/util/pointer.hh>
 #include <hpp/core/path-vector.hh>
+#include <hpp/core/configuration-layout.hh>
 #include <hpp/core/distance.hh>
 #include <hpp/core/steering-method.hh>
+#include <hpp/core/weighed-distance.hh>
 
 namespace hpp {
   namespace core {
     PathProjector::PathProjector (const DistancePtr_t& distance,
 				  const SteeringMethodPtr_t& steeringMethod,
 				  bool keepSteeringMethodConstraints) :
-      distance_ (distance), steeringMethod_ (steeringMethod->copy ())
+      distance_ (distance), steeringMethod_ (steeringMethod->copy ()),
+      weighedDistance_ (HPP_DYNAMIC_PTR_CAST (WeighedDistance, distance))
     {
       assert (distance_ != NULL);
       assert (steeringMethod_ != NULL);
@@ -51,6 +54,15 @@ namespace hpp {
       return result;
     }
 
+    ConfigurationLayoutPtr_t PathProjector::layout
+    (const DevicePtr_t& robot) const
+    {
+      if (weighedDistance_ && weighedDistance_->robot () == robot) {
+	return weighedDistance_->layout ();
+      }
+      return ConfigurationLayout::create (robot);
+    }
+
     bool PathProjector::apply (const PathPtr_t& path,
 			       PathPtr_t& proj) const
     {
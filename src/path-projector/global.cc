@@ -219,7 +219,7 @@ namespace hpp {
         }
 
         InterpolatedPathPtr_t out = InterpolatedPath::create
-          (robot, q.front(), *itCl, length, constraint);
+          (robot, q.front(), *itCl, length, constraint, layout (robot));
 
         if (itCl != q.begin ()) {
           length = 0;
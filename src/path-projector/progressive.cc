@@ -141,7 +141,7 @@ namespace hpp {
           default:
             InterpolatedPathPtr_t p = InterpolatedPath::create
               (path->device (), q1, q2, totalLength,
-               path->constraints ());
+               path->constraints (), layout (path->device ()));
             value_type t = paths.front ()->length ();
             qi = paths.front()->end ();
             paths.pop ();
@@ -16,6 +16,8 @@
 // hpp-core  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <limits>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <hpp/core/path-optimizer.hh>
 #include <hpp/core/plan-and-optimize.hh>
 
@@ -42,6 +44,34 @@ namespace hpp {
       return result;
     }
 
+    PathVectorPtr_t PlanAndOptimize::finishSolve (const PathVectorPtr_t& path,
+						  value_type maxTime)
+    {
+      if (maxTime == std::numeric_limits <value_type>::infinity ()) {
+	return finishSolve (path);
+      }
+      const boost::posix_time::ptime start
+	(boost::posix_time::microsec_clock::universal_time ());
+      PathVectorPtr_t result = path;
+      for (std::size_t i = 0; i < optimizers_.size (); ++i) {
+	boost::posix_time::time_duration elapsed
+	  (boost::posix_time::microsec_clock::universal_time () - start);
+	value_type remaining =
+	  maxTime - 1e-6 * (value_type) elapsed.total_microseconds ();
+	if (remaining <= 0) break;
+	const PathOptimizerPtr_t& optimizer (optimizers_ [i]);
+	optimizer->maxTime (remaining / (value_type) (optimizers_.size () - i));
+	result = optimizer->optimize (result);
+	optimizer->maxTime (std::numeric_limits <value_type>::infinity ());
+      }
+      return result;
+    }
+
+    bool PlanAndOptimize::anytime () const
+    {
+      return pathPlanner_->anytime ();
+    }
+
     void PlanAndOptimize::addPathOptimizer
     (const PathOptimizerPtr_t& optimizer)
     {
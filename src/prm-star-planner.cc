@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <cmath>
+#include <limits>
+#include <hpp/util/debug.hh>
+#include <hpp/model/device.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/configuration-shooter.hh>
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/constraint-set.hh>
+#include <hpp/core/nearest-neighbor.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/path.hh>
+#include <hpp/core/path-projector.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/path-vector.hh>
+#include <hpp/core/prm-star-planner.hh>
+#include <hpp/core/problem.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/steering-method.hh>
+
+namespace hpp {
+  namespace core {
+    PrmStarPlannerPtr_t PrmStarPlanner::createWithRoadmap
+    (const Problem& problem, const RoadmapPtr_t& roadmap)
+    {
+      PrmStarPlanner* ptr = new PrmStarPlanner (problem, roadmap);
+      PrmStarPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    PrmStarPlannerPtr_t PrmStarPlanner::create (const Problem& problem)
+    {
+      PrmStarPlanner* ptr = new PrmStarPlanner (problem);
+      PrmStarPlannerPtr_t shPtr (ptr);
+      ptr->init (shPtr);
+      return shPtr;
+    }
+
+    PrmStarPlanner::PrmStarPlanner (const Problem& problem) :
+      PathPlanner (problem),
+      configurationShooter_ (problem.configurationShooter ()),
+      kPrm_ (M_E * (1 + 1. / (value_type) problem.robot ()->numberDof ())),
+      bestCost_ (std::numeric_limits <value_type>::infinity ()),
+      bestPath_ ()
+    {
+    }
+
+    PrmStarPlanner::PrmStarPlanner (const Problem& problem,
+				    const RoadmapPtr_t& roadmap) :
+      PathPlanner (problem, roadmap),
+      configurationShooter_ (problem.configurationShooter ()),
+      kPrm_ (M_E * (1 + 1. / (value_type) problem.robot ()->numberDof ())),
+      bestCost_ (std::numeric_limits <value_type>::infinity ()),
+      bestPath_ ()
+    {
+    }
+
+    void PrmStarPlanner::init (const PrmStarPlannerWkPtr_t& weak)
+    {
+      PathPlanner::init (weak);
+      weakPtr_ = weak;
+    }
+
+    void PrmStarPlanner::startSolve ()
+    {
+      PathPlanner::startSolve ();
+      bestCost_ = std::numeric_limits <value_type>::infinity ();
+      bestPath_.reset ();
+    }
+
+    std::size_t PrmStarPlanner::numberOfNeighbors (std::size_t n) const
+    {
+      if (n < 2) return 1;
+      return (std::size_t) std::ceil (kPrm_ * std::log ((value_type) n));
+    }
+
+    void PrmStarPlanner::oneStep ()
+    {
+      DevicePtr_t robot (problem ().robot ());
+      ConfigValidationsPtr_t configValidations (problem ().configValidations());
+      ConstraintSetPtr_t constraints (problem ().constraints ());
+      const RoadmapPtr_t& r (roadmap ());
+      // Shoot one random configuration per step, so that a step stays
+      // short when most configurations are invalid.
+      ConfigurationPtr_t q_rand = configurationShooter_->shoot ();
+      if (constraints && !constraints->apply (*q_rand)) return;
+      robot->currentConfiguration (*q_rand);
+      robot->computeForwardKinematics ();
+      ValidationReportPtr_t report;
+      if (!configValidations->validate (*q_rand, report)) return;
+      const std::size_t n = r->configurations ().cols ();
+      NodePtr_t newNode = r->addNode (q_rand);
+      // The configuration is already in the roadmap
+      if ((std::size_t) r->configurations ().cols () == n) return;
+
+      // k nearest nodes of the roadmap, the new node being one of them.
+      // They are collected before connecting, since connections merge the
+      // connected components.
+      const std::size_t k = numberOfNeighbors (n + 1);
+      Nodes_t neighbors = r->nearestNeighbor ()->kNearest (q_rand, k + 1);
+      bool connected = false;
+      for (Nodes_t::const_iterator itNode = neighbors.begin ();
+	   itNode != neighbors.end (); ++itNode) {
+	if (*itNode == newNode) continue;
+	if (connect (*itNode, newNode)) connected = true;
+      }
+
+      // Update the best path. The shortest path can only change if the new
+      // node has been connected to the connected component of the initial
+      // node, unless the first path was found by another method
+      // (tryDirectPath for instance).
+      if (!r->pathExists ()) return;
+      if (bestPath_ && !(connected && newNode->connectedComponent () ==
+			 r->initNode ()->connectedComponent ())) return;
+      PathVectorPtr_t path = computePath ();
+      if (path && path->length () < bestCost_) {
+	hppDout (info, "best path length: " << path->length ());
+	bestCost_ = path->length ();
+	bestPath_ = path;
+      }
+    }
+
+    bool PrmStarPlanner::connect (const NodePtr_t& n1, const NodePtr_t& n2)
+    {
+      const SteeringMethodPtr_t& sm (problem ().steeringMethod ());
+      PathValidationPtr_t pathValidation (problem ().pathValidation ());
+      PathProjectorPtr_t pathProjector (problem ().pathProjector ());
+      PathPtr_t path = (*sm) (*(n1->configuration ()), *(n2->configuration ()));
+      if (!path) return false;
+      PathPtr_t projPath, validPath;
+      if (pathProjector) {
+	if (!pathProjector->apply (path, projPath)) return false;
+      } else {
+	projPath = path;
+      }
+      PathValidationReportPtr_t report;
+      if (!pathValidation->validate (projPath, false, validPath, report)) {
+	return false;
+      }
+      roadmap ()->addEdge (n1, n2, projPath);
+      interval_t timeRange = projPath->timeRange ();
+      roadmap ()->addEdge (n2, n1, projPath->extract
+			   (interval_t (timeRange.second, timeRange.first)));
+      return true;
+    }
+
+    void PrmStarPlanner::configurationShooter
+    (const ConfigurationShooterPtr_t& shooter)
+    {
+      configurationShooter_ = shooter;
+    }
+  } // namespace core
+} // namespace hpp
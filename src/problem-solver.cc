@@ -16,12 +16,23 @@
 // hpp-core  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <limits>
+#include <sstream>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <hpp/util/debug.hh>
 #include <hpp/model/collision-object.hh>
 #include <hpp/constraints/differentiable-function.hh>
 #include <hpp/core/problem-solver.hh>
+#include <hpp/core/bi-rrt-planner.hh>
+#include <hpp/core/constrained-configuration-shooter.hh>
 #include <hpp/core/diffusing-planner.hh>
 #include <hpp/core/distance-between-objects.hh>
+#include <hpp/core/halton-configuration-shooter.hh>
+#include <hpp/core/lazy-prm-planner.hh>
 #include <hpp/core/roadmap.hh>
 #include <hpp/core/discretized-collision-checking.hh>
 #include <hpp/core/continuous-collision-checking/dichotomy.hh>
@@ -32,12 +43,18 @@
 #include <hpp/core/path-optimization/gradient-based.hh>
 #include <hpp/core/path-optimization/partial-shortcut.hh>
 #include <hpp/core/path-optimization/config-optimization.hh>
+#include <hpp/core/prm-star-planner.hh>
+#include <hpp/core/random-engine.hh>
 #include <hpp/core/random-shortcut.hh>
 #include <hpp/core/roadmap.hh>
 #include <hpp/core/steering-method-straight.hh>
 #include <hpp/core/visibility-prm-planner.hh>
 #include <hpp/core/weighed-distance.hh>
 #include <hpp/core/basic-configuration-shooter.hh>
+#include "nearest-neighbor/basic.hh"
+#include "nearest-neighbor/k-d-forest.hh"
+#include "nearest-neighbor/k-d-tree.hh"
+#include "nearest-neighbor/vp-tree.hh"
 
 namespace hpp {
   namespace core {
@@ -60,6 +77,47 @@ namespace hpp {
       }
     }; // struct NonePathProjector
 
+    // Structs that construct nearest neighbor methods with default
+    // parameters.
+    struct BasicNearestNeighbor
+    {
+      static NearestNeighborPtr_t create (const DevicePtr_t&,
+					  const DistancePtr_t& distance)
+      {
+	return NearestNeighborPtr_t (new nearestNeighbor::Basic (distance));
+      }
+    }; // struct BasicNearestNeighbor
+
+    struct KDTreeNearestNeighbor
+    {
+      static NearestNeighborPtr_t create (const DevicePtr_t& robot,
+					  const DistancePtr_t& distance)
+      {
+	return NearestNeighborPtr_t
+	  (new nearestNeighbor::KDTree (robot, distance, 30));
+      }
+    }; // struct KDTreeNearestNeighbor
+
+    struct VPTreeNearestNeighbor
+    {
+      static NearestNeighborPtr_t create (const DevicePtr_t&,
+					  const DistancePtr_t& distance)
+      {
+	return NearestNeighborPtr_t
+	  (new nearestNeighbor::VPTree (distance, 30));
+      }
+    }; // struct VPTreeNearestNeighbor
+
+    struct KDForestNearestNeighbor
+    {
+      static NearestNeighborPtr_t create (const DevicePtr_t& robot,
+					  const DistancePtr_t& distance)
+      {
+	return NearestNeighborPtr_t
+	  (new nearestNeighbor::KDForest (robot, distance, 4, 30));
+      }
+    }; // struct KDForestNearestNeighbor
+
     ProblemSolverPtr_t ProblemSolver::latest_ = 0x0;
     ProblemSolverPtr_t ProblemSolver::create ()
     {
@@ -80,9 +138,13 @@ namespace hpp {
       pathPlannerType_ ("DiffusingPlanner"),
       initConf_ (), goalConfigurations_ (),
       configurationShooterType_ ("BasicConfigurationShooter"),
-      pathOptimizerTypes_ (), pathOptimizers_ (),
+      nearestNeighborType_ ("Basic"),
+      pathOptimizerTypes_ (), pathOptimizers_ (), portfolio_ (),
+      portfolioMutex_ (),
       pathValidationType_ ("Discretized"), pathValidationTolerance_ (0.05),
+      numberOfThreads_ (1),
       pathPlannerFactory_ (), configurationShooterFactory_ (),
+      nearestNeighborFactory_ (),
       pathOptimizerFactory_ (), pathValidationFactory_ (),
       collisionObstacles_ (), distanceObstacles_ (), obstacleMap_ (),
       errorThreshold_ (1e-4), maxIterations_ (20), numericalConstraintMap_ (),
@@ -93,8 +155,26 @@ namespace hpp {
 	DiffusingPlanner::createWithRoadmap;
       pathPlannerFactory_ ["VisibilityPrmPlanner"] =
 	VisibilityPrmPlanner::createWithRoadmap;
+      pathPlannerFactory_ ["LazyPrmPlanner"] =
+	LazyPrmPlanner::createWithRoadmap;
+      pathPlannerFactory_ ["BiRRTPlanner"] =
+	BiRRTPlanner::createWithRoadmap;
+      pathPlannerFactory_ ["PrmStarPlanner"] =
+	PrmStarPlanner::createWithRoadmap;
       configurationShooterFactory_ ["BasicConfigurationShooter"] =
         BasicConfigurationShooter::create;
+      configurationShooterFactory_ ["HaltonConfigurationShooter"] =
+        HaltonConfigurationShooter::create;
+      // The constraints are read when the shooter is created, at the
+      // beginning of each resolution.
+      configurationShooterFactory_ ["ConstrainedConfigurationShooter"] =
+        boost::bind (&ConstrainedConfigurationShooter::create, _1,
+                     boost::cref (constraints_));
+      // Store nearest neighbor methods in map.
+      nearestNeighborFactory_ ["Basic"] = BasicNearestNeighbor::create;
+      nearestNeighborFactory_ ["KDTree"] = KDTreeNearestNeighbor::create;
+      nearestNeighborFactory_ ["VPTree"] = VPTreeNearestNeighbor::create;
+      nearestNeighborFactory_ ["KDForest"] = KDForestNearestNeighbor::create;
       // Store path optimization methods in map.
       pathOptimizerFactory_ ["RandomShortcut"] = RandomShortcut::create;
       pathOptimizerFactory_ ["GradientBased"] =
@@ -145,6 +225,20 @@ namespace hpp {
       configurationShooterType_ = type;
     }
 
+    void ProblemSolver::nearestNeighborType (const std::string& type)
+    {
+      if (nearestNeighborFactory_.find (type) ==
+	  nearestNeighborFactory_.end ()) {
+	throw std::runtime_error (std::string ("No nearest neighbor method with "
+					       "name ") + type);
+      }
+      nearestNeighborType_ = type;
+      // If a roadmap exists, set nearest neighbor method
+      if (roadmap_ && problem_) {
+	roadmap_->nearestNeighbor (createNearestNeighbor (*problem_));
+      }
+    }
+
     void ProblemSolver::addPathOptimizer (const std::string& type)
     {
       if (pathOptimizerFactory_.find (type) == pathOptimizerFactory_.end ()) {
@@ -170,6 +264,30 @@ namespace hpp {
       }
     }
 
+    void ProblemSolver::optimizePath (PathVectorPtr_t path, value_type maxTime)
+    {
+      if (maxTime == std::numeric_limits <value_type>::infinity ()) {
+	optimizePath (path);
+	return;
+      }
+      const boost::posix_time::ptime start
+	(boost::posix_time::microsec_clock::universal_time ());
+      createPathOptimizers ();
+      for (std::size_t i = 0; i < pathOptimizers_.size (); ++i) {
+	boost::posix_time::time_duration elapsed
+	  (boost::posix_time::microsec_clock::universal_time () - start);
+	value_type remaining =
+	  maxTime - 1e-6 * (value_type) elapsed.total_microseconds ();
+	if (remaining <= 0) break;
+	const PathOptimizerPtr_t& optimizer (pathOptimizers_ [i]);
+	optimizer->maxTime (remaining /
+			    (value_type) (pathOptimizers_.size () - i));
+	path = optimizer->optimize (path);
+	optimizer->maxTime (std::numeric_limits <value_type>::infinity ());
+	paths_.push_back (path);
+      }
+    }
+
     void ProblemSolver::pathValidationType (const std::string& type,
 					    const value_type& tolerance)
     {
@@ -185,6 +303,9 @@ namespace hpp {
 	  pathValidationFactory_ [pathValidationType_]
 	  (robot_, pathValidationTolerance_);
 	problem_->pathValidation (pathValidation);
+	problem_->pathValidationBuilder
+	  (pathValidationFactory_ [pathValidationType_],
+	   pathValidationTolerance_);
       }
     }
 
@@ -326,6 +447,9 @@ namespace hpp {
 	pathValidationFactory_ [pathValidationType_] (robot_,
 						      pathValidationTolerance_);
       problem_->pathValidation (pathValidation);
+      problem_->pathValidationBuilder
+	(pathValidationFactory_ [pathValidationType_],
+	 pathValidationTolerance_);
       // Set obstacles
       problem_->collisionObstacles(collisionObstacles_);
       // Distance to obstacles
@@ -339,6 +463,7 @@ namespace hpp {
       if (!problem_)
         throw std::runtime_error ("The problem is not defined.");
       roadmap_ = Roadmap::create (problem_->distance (), problem_->robot());
+      roadmap_->nearestNeighbor (createNearestNeighbor (*problem_));
     }
 
     void ProblemSolver::createPathOptimizers ()
@@ -361,6 +486,7 @@ namespace hpp {
       PathPlannerBuilder_t createPlanner =
 	pathPlannerFactory_ [pathPlannerType_];
       pathPlanner_ = createPlanner (*problem_, roadmap_);
+      parallelValidation (pathPlanner_);
       /// create Path projector
       PathProjectorBuilder_t createProjector =
         pathProjectorFactory_ [pathProjectorType_];
@@ -390,6 +516,43 @@ namespace hpp {
       return roadmap_->pathExists ();
     }
 
+    void ProblemSolver::parallelValidation (const PathPlannerPtr_t& planner)
+      const
+    {
+      if (numberOfThreads_ <= 1) return;
+      DiffusingPlannerPtr_t diffusingPlanner
+	(HPP_DYNAMIC_PTR_CAST (DiffusingPlanner, planner));
+      if (diffusingPlanner) {
+	diffusingPlanner->pathValidations
+	  (problem_->pathValidations (numberOfThreads_));
+      }
+      VisibilityPrmPlannerPtr_t visibilityPrmPlanner
+	(HPP_DYNAMIC_PTR_CAST (VisibilityPrmPlanner, planner));
+      if (visibilityPrmPlanner) {
+	visibilityPrmPlanner->pathValidations
+	  (problem_->pathValidations (numberOfThreads_));
+      }
+    }
+
+    NearestNeighborPtr_t ProblemSolver::createNearestNeighbor
+    (const Problem& problem) const
+    {
+      NearestNeighborFactory_t::const_iterator it
+	(nearestNeighborFactory_.find (nearestNeighborType_));
+      assert (it != nearestNeighborFactory_.end ());
+      NearestNeighborPtr_t result
+	(it->second (problem.robot (), problem.distance ()));
+      // The forest does not draw from the engine of the problem itself, so
+      // that the configurations shot do not depend on the nearest neighbor
+      // method.
+      boost::shared_ptr <nearestNeighbor::KDForest> kdForest
+	(HPP_DYNAMIC_PTR_CAST (nearestNeighbor::KDForest, result));
+      if (kdForest) {
+	kdForest->randomEngine (problem.randomEngine ()->stream (0));
+      }
+      return result;
+    }
+
     void ProblemSolver::finishSolveStepByStep ()
     {
       if (!roadmap_->pathExists ())
@@ -400,12 +563,21 @@ namespace hpp {
 
     void ProblemSolver::solve ()
     {
+      solve (std::numeric_limits <value_type>::infinity (),
+	     std::numeric_limits <std::size_t>::max ());
+    }
+
+    void ProblemSolver::solve (value_type maxTime, std::size_t maxIterations)
+    {
+      const boost::posix_time::ptime start
+	(boost::posix_time::microsec_clock::universal_time ());
       // Set shooter
       problem_->configurationShooter
         (configurationShooterFactory_ [configurationShooterType_] (robot_));
       PathPlannerBuilder_t createPlanner =
 	pathPlannerFactory_ [pathPlannerType_];
       pathPlanner_ = createPlanner (*problem_, roadmap_);
+      parallelValidation (pathPlanner_);
       /// create Path projector
       PathProjectorBuilder_t createProjector =
         pathProjectorFactory_ [pathProjectorType_];
@@ -424,14 +596,169 @@ namespace hpp {
 	   itConfig != goalConfigurations_.end (); ++itConfig) {
 	problem_->addGoalConfig (*itConfig);
       }
-      PathVectorPtr_t path = pathPlanner_->solve ();
+      PathVectorPtr_t path = pathPlanner_->solve (maxTime, maxIterations);
       paths_.push_back (path);
-      optimizePath (path);
+      boost::posix_time::time_duration elapsed
+	(boost::posix_time::microsec_clock::universal_time () - start);
+      optimizePath (path,
+		    maxTime - 1e-6 * (value_type) elapsed.total_microseconds ());
+    }
+
+    namespace {
+      // Path planners racing in solvePortfolio
+      struct Race
+      {
+	Race (const ProblemSolver::PathPlanners_t& planners) :
+	  planners (planners), paths (planners.size ()),
+	  errors (planners.size ()), winner (planners.size ()), finished (0)
+	{
+	}
+	ProblemSolver::PathPlanners_t planners;
+	PathVectors_t paths;
+	std::vector <std::string> errors;
+	// Index of the first planner that found a path, number of planners
+	// if none.
+	std::size_t winner;
+	// Number of planners that returned
+	std::size_t finished;
+	boost::mutex mutex;
+	boost::condition_variable condition;
+      }; // struct Race
+
+      void runPlanner (Race* race, std::size_t i, value_type maxTime,
+		       std::size_t maxIterations)
+      {
+	PathVectorPtr_t path;
+	std::string error;
+	try {
+	  path = race->planners [i]->solve (maxTime, maxIterations);
+	} catch (const std::exception& exc) {
+	  error = exc.what ();
+	}
+	boost::mutex::scoped_lock lock (race->mutex);
+	race->paths [i] = path;
+	race->errors [i] = error;
+	if (path && race->winner == race->planners.size ()) {
+	  race->winner = i;
+	}
+	++race->finished;
+	race->condition.notify_all ();
+      }
+    } // namespace
+
+    void ProblemSolver::solvePortfolio
+    (const PathPlannerTypes_t& pathPlannerTypes, value_type maxTime,
+     std::size_t maxIterations)
+    {
+      const boost::posix_time::ptime start
+	(boost::posix_time::microsec_clock::universal_time ());
+      const std::size_t n = pathPlannerTypes.size ();
+      if (n == 0) {
+	throw std::runtime_error ("solvePortfolio: no path planner.");
+      }
+      for (PathPlannerTypes_t::const_iterator itType =
+	     pathPlannerTypes.begin (); itType != pathPlannerTypes.end ();
+	   ++itType) {
+	if (pathPlannerFactory_.find (*itType) == pathPlannerFactory_.end ()) {
+	  throw std::runtime_error (std::string ("No path planner with name ")
+				    + *itType);
+	}
+      }
+      if (constraints_ && constraints_->begin () != constraints_->end ()) {
+	throw std::runtime_error ("solvePortfolio: constraints are defined on "
+				  "the robot and cannot be shared between "
+				  "threads.");
+      }
+      // Build one problem per planner on a copy of the robot. Problems are
+      // declared before planners so that they are destroyed after them.
+      std::vector <boost::shared_ptr <Problem> > problems;
+      PathPlanners_t planners;
+      ValidationContexts_t contexts (problem_->validationContexts (n));
+      for (std::size_t i = 0; i < n; ++i) {
+	const DevicePtr_t& robot (contexts [i]->robot ());
+	boost::shared_ptr <Problem> problem (new Problem (robot));
+	problem->configValidation (contexts [i]->configValidations ());
+	problem->pathValidation (contexts [i]->pathValidation ());
+	problem->randomEngine (problem_->randomEngine ()->stream (i));
+	problem->configurationShooter
+	  (configurationShooterFactory_ [configurationShooterType_] (robot));
+	problem->pathProjector
+	  (pathProjectorFactory_ [pathProjectorType_]
+	   (problem->distance (), problem->steeringMethod (),
+	    pathProjectorTolerance_));
+	problem->initConfig (initConf_);
+	for (Configurations_t::const_iterator itConfig =
+	       goalConfigurations_.begin ();
+	     itConfig != goalConfigurations_.end (); ++itConfig) {
+	  problem->addGoalConfig (*itConfig);
+	}
+	RoadmapPtr_t roadmap (Roadmap::create (problem->distance (), robot));
+	roadmap->nearestNeighbor (createNearestNeighbor (*problem));
+	planners.push_back (pathPlannerFactory_ [pathPlannerTypes [i]]
+			    (*problem, roadmap));
+	problems.push_back (problem);
+      }
+
+      Race race (planners);
+      {
+	boost::mutex::scoped_lock lock (portfolioMutex_);
+	portfolio_ = planners;
+      }
+      boost::thread_group threads;
+      for (std::size_t i = 0; i < n; ++i) {
+	threads.create_thread (boost::bind (&runPlanner, &race, i, maxTime,
+					    maxIterations));
+      }
+      {
+	boost::mutex::scoped_lock lock (race.mutex);
+	while (race.winner == n && race.finished < n) {
+	  race.condition.wait (lock);
+	}
+	// Interrupt the other planners until they return: a planner that
+	// has not started yet clears the interruption when it starts.
+	while (race.finished < n) {
+	  for (std::size_t i = 0; i < n; ++i) {
+	    if (i != race.winner) planners [i]->interrupt ();
+	  }
+	  race.condition.timed_wait (lock,
+				     boost::posix_time::milliseconds (1));
+	}
+      }
+      threads.join_all ();
+      {
+	boost::mutex::scoped_lock lock (portfolioMutex_);
+	portfolio_.clear ();
+      }
+
+      if (race.winner == n) {
+	std::ostringstream oss;
+	oss << "No path found by the portfolio of path planners:";
+	for (std::size_t i = 0; i < n; ++i) {
+	  oss << std::endl << "  " << pathPlannerTypes [i] << ": "
+	      << race.errors [i];
+	}
+	throw std::runtime_error (oss.str ().c_str ());
+      }
+      hppDout (info, "path found by path planner "
+	       << pathPlannerTypes [race.winner] << " (" << race.winner << ")");
+      PathVectorPtr_t path = race.paths [race.winner];
+      paths_.push_back (path);
+      boost::posix_time::time_duration elapsed
+	(boost::posix_time::microsec_clock::universal_time () - start);
+      optimizePath (path,
+		    maxTime - 1e-6 * (value_type) elapsed.total_microseconds ());
     }
 
     void ProblemSolver::interrupt ()
     {
       if (pathPlanner ()) pathPlanner ()->interrupt ();
+      {
+	boost::mutex::scoped_lock lock (portfolioMutex_);
+	for (PathPlanners_t::iterator it = portfolio_.begin ();
+	     it != portfolio_.end (); ++it) {
+	  (*it)->interrupt ();
+	}
+      }
       for (PathOptimizers_t::iterator it = pathOptimizers_.begin ();
 	   it != pathOptimizers_.end (); ++it) {
 	(*it)->interrupt ();
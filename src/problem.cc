@@ -30,6 +30,7 @@
 #include <hpp/core/continuous-collision-checking/dichotomy.hh>
 #include <hpp/core/continuous-collision-checking/progressive.hh>
 #include <hpp/core/basic-configuration-shooter.hh>
+#include <hpp/core/random-engine.hh>
 
 namespace hpp {
   namespace core {
@@ -44,9 +45,13 @@ namespace hpp {
       configValidations_ (ConfigValidations::create ()),
       pathValidation_ (DiscretizedCollisionChecking::create
 		       (robot, 0.05)),
-      collisionObstacles_ (), constraints_ (),
-      configurationShooter_(BasicConfigurationShooter::create (robot))
+      collisionObstacles_ (), removedPairs_ (), constraints_ (),
+      configurationShooter_(BasicConfigurationShooter::create (robot)),
+      randomEngine_ (RandomEngine::create ()), validationContexts_ (),
+      pathValidationBuilder_ (DiscretizedCollisionChecking::create),
+      pathValidationTolerance_ (0.05)
     {
+      configurationShooter_->randomEngine (randomEngine_);
       configValidations_->add (CollisionValidation::create (robot));
       configValidations_->add (JointBoundValidation::create (robot));
     }
@@ -117,6 +122,11 @@ namespace hpp {
       if (configValidations_) {
 	configValidations_->addObstacle (object);
       }
+      for (ValidationContexts_t::const_iterator itContext =
+	     validationContexts_.begin ();
+	   itContext != validationContexts_.end (); ++itContext) {
+	(*itContext)->addObstacle (object);
+      }
     }
 
     // ======================================================================
@@ -124,12 +134,18 @@ namespace hpp {
     void Problem::removeObstacleFromJoint (const JointPtr_t& joint,
 					   const CollisionObjectPtr_t& obstacle)
     {
+      removedPairs_.push_back (std::make_pair (joint, obstacle));
       if (pathValidation_) {
 	pathValidation_->removeObstacleFromJoint (joint, obstacle);
       }
       if (configValidations_) {
 	configValidations_->removeObstacleFromJoint (joint, obstacle);
       }
+      for (ValidationContexts_t::const_iterator itContext =
+	     validationContexts_.begin ();
+	   itContext != validationContexts_.end (); ++itContext) {
+	(*itContext)->removeObstacleFromJoint (joint, obstacle);
+      }
     }
 
     // ======================================================================
@@ -149,6 +165,70 @@ namespace hpp {
     void Problem::configurationShooter (const ConfigurationShooterPtr_t& configurationShooter)
     {
       configurationShooter_ = configurationShooter;
+      configurationShooter_->randomEngine (randomEngine_);
+    }
+
+    // ======================================================================
+
+    void Problem::pathValidationBuilder
+    (const ValidationContext::PathValidationBuilder_t& builder,
+     const value_type& tolerance)
+    {
+      pathValidationBuilder_ = builder;
+      pathValidationTolerance_ = tolerance;
+      validationContexts_.clear ();
+    }
+
+    // ======================================================================
+
+    ValidationContexts_t Problem::validationContexts (std::size_t n) const
+    {
+      if (validationContexts_.empty () && n > 0) {
+	ValidationContextPtr_t context
+	  (ValidationContext::create (robot_, pathValidationBuilder_,
+				      pathValidationTolerance_));
+	for (ObjectVector_t::const_iterator itObj =
+	       collisionObstacles_.begin ();
+	     itObj != collisionObstacles_.end (); ++itObj) {
+	  context->addObstacle (*itObj);
+	}
+	for (std::vector <std::pair <JointPtr_t, CollisionObjectPtr_t> >::
+	       const_iterator itPair = removedPairs_.begin ();
+	     itPair != removedPairs_.end (); ++itPair) {
+	  context->removeObstacleFromJoint (itPair->first, itPair->second);
+	}
+	validationContexts_.push_back (context);
+      }
+      // Further contexts are copies of the first one: obstacles and
+      // removed collision pairs are replayed on them.
+      while (validationContexts_.size () < n) {
+	validationContexts_.push_back (validationContexts_.front ()->clone ());
+      }
+      return ValidationContexts_t (validationContexts_.begin (),
+				   validationContexts_.begin () + n);
+    }
+
+    // ======================================================================
+
+    PathValidations_t Problem::pathValidations (std::size_t n) const
+    {
+      ValidationContexts_t contexts (validationContexts (n));
+      PathValidations_t result;
+      for (ValidationContexts_t::const_iterator itContext = contexts.begin ();
+	   itContext != contexts.end (); ++itContext) {
+	result.push_back ((*itContext)->pathValidation ());
+      }
+      return result;
+    }
+
+    // ======================================================================
+
+    void Problem::randomEngine (const RandomEnginePtr_t& randomEngine)
+    {
+      randomEngine_ = randomEngine;
+      if (configurationShooter_) {
+	configurationShooter_->randomEngine (randomEngine_);
+      }
     }
 
     // ======================================================================
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <hpp/core/random-engine.hh>
+
+namespace hpp {
+  namespace core {
+    namespace {
+      // Scramble the bits of the seed of a stream, so that streams of
+      // consecutive indices start from unrelated states.
+      unsigned int mix (unsigned int seed, std::size_t index)
+      {
+	boost::uint32_t x = seed ^ (boost::uint32_t) (0x9e3779b9u * (index + 1));
+	x ^= x >> 16;
+	x *= 0x85ebca6bu;
+	x ^= x >> 13;
+	x *= 0xc2b2ae35u;
+	x ^= x >> 16;
+	return x;
+      }
+    } // namespace
+
+    RandomEnginePtr_t RandomEngine::create (unsigned int seed)
+    {
+      return RandomEnginePtr_t (new RandomEngine (seed));
+    }
+
+    RandomEngine::RandomEngine (unsigned int seed) :
+      seed_ (seed), generator_ (seed)
+    {
+    }
+
+    void RandomEngine::seed (unsigned int seed)
+    {
+      seed_ = seed;
+      generator_.seed (seed);
+    }
+
+    RandomEnginePtr_t RandomEngine::stream (std::size_t index) const
+    {
+      return create (mix (seed_, index));
+    }
+
+    value_type RandomEngine::uniform ()
+    {
+      return boost::random::uniform_01 <value_type> () (generator_);
+    }
+
+    std::size_t RandomEngine::uniformInt (std::size_t n)
+    {
+      return boost::random::uniform_int_distribution <std::size_t>
+	(0, n - 1) (generator_);
+    }
+  } //   namespace core
+} // namespace hpp
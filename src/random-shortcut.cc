@@ -18,13 +18,13 @@
 
 #include <limits>
 #include <deque>
-#include <cstdlib>
 #include <hpp/util/assertion.hh>
 #include <hpp/util/debug.hh>
 #include <hpp/core/distance.hh>
 #include <hpp/core/path-validation.hh>
 #include <hpp/core/path-vector.hh>
 #include <hpp/core/problem.hh>
+#include <hpp/core/random-engine.hh>
 #include <hpp/core/random-shortcut.hh>
 
 namespace hpp {
@@ -74,11 +74,12 @@ namespace hpp {
       PathVectorPtr_t result;
       Configuration_t q1 (path->outputSize ()),
                       q2 (path->outputSize ());
+      RandomEngine& engine (*problem ().randomEngine ());
 
       while (!finished) {
 	t3 = tmpPath->timeRange ().second;
-	value_type u2 = t3 * rand ()/RAND_MAX;
-	value_type u1 = t3 * rand ()/RAND_MAX;
+	value_type u2 = t3 * engine.uniform ();
+	value_type u1 = t3 * engine.uniform ();
 	value_type t1, t2;
 	if (u1 < u2) {t1 = u1; t2 = u2;} else {t1 = u2; t2 = u1;}
 	if (!(*tmpPath) (q1, t1)) {
@@ -127,7 +128,7 @@ namespace hpp {
 				 as <PathVector> ()));
 	length.push_back (pathLength (result, problem ().distance ()));
 	length.pop_front ();
-	finished = (length [0] <= length [n-1]);
+	finished = (length [0] <= length [n-1]) || stop ();
 	hppDout (info, "length = " << length [n-1]);
 	tmpPath = result;
       }
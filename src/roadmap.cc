@@ -38,10 +38,12 @@ namespace hpp {
     }
 
     Roadmap::Roadmap (const DistancePtr_t& distance, const DevicePtr_t&) :
-      distance_ (distance), connectedComponents_ (), nodes_ (), edges_ (),
+      distance_ (distance), connectedComponents_ (), nodes_ (),
+      configurations_ (), nodeCount_ (0), edges_ (),
       initNode_ (), goalNodes_ (),
       nearestNeighbor_ (new nearestNeighbor::Basic (distance))
     {
+      nearestNeighbor_->configurations (configurations_);
     }
 
     Roadmap::~Roadmap ()
@@ -61,11 +63,12 @@ namespace hpp {
 
 
     void Roadmap::nearestNeighbor(NearestNeighborPtr_t nearestNeighbor){
-      if (nodes_.size() != 0) {
-        throw std::runtime_error ("The roadmap must be empty before setting a new NearestNeighbor object.");
-      }
-      if(nearestNeighbor)
+      if(nearestNeighbor) {
         nearestNeighbor_ = nearestNeighbor;
+        nearestNeighbor_->configurations (configurations_);
+        // Insert the nodes already in the roadmap in one go
+        nearestNeighbor_->build (nodes_);
+      }
     }
 
     void Roadmap::clear ()
@@ -76,6 +79,7 @@ namespace hpp {
 	delete *it;
       }
       nodes_.clear ();
+      nodeCount_ = 0;
 
       for (Edges_t::iterator it = edges_.begin (); it != edges_.end (); ++it) {
 	delete *it;
@@ -98,6 +102,7 @@ namespace hpp {
       }
       NodePtr_t node = createNode (configuration);
       hppDout (info, "Added node: " << displayConfig (*configuration));
+      storeConfiguration (node);
       push_node (node);
       // Node constructor creates a new connected component. This new
       // connected component needs to be added in the roadmap and the
@@ -121,6 +126,7 @@ namespace hpp {
       NodePtr_t node = createNode (configuration);
       node->connectedComponent (connectedComponent);
       hppDout (info, "Added node: " << displayConfig (*configuration));
+      storeConfiguration (node);
       push_node (node);
       // The new node needs to be registered in the connected
       // component.
@@ -129,6 +135,20 @@ namespace hpp {
       return node;
     }
 
+    void Roadmap::storeConfiguration (const NodePtr_t& node)
+    {
+      const Configuration_t& q (*(node->configuration ()));
+      // Capacity is doubled so that nodes are added in amortized constant
+      // time.
+      if (nodeCount_ == (std::size_t) configurations_.cols ()) {
+	configurations_.conservativeResize
+	  (q.size (), std::max <size_type> (16, 2 * nodeCount_));
+      }
+      configurations_.col (nodeCount_) = q;
+      node->index (nodeCount_);
+      ++nodeCount_;
+    }
+
     void Roadmap::addEdges (const NodePtr_t from, const NodePtr_t& to,
 			    const PathPtr_t& path)
     {
@@ -155,19 +175,8 @@ namespace hpp {
     Roadmap::nearestNode (const ConfigurationPtr_t& configuration,
 			  value_type& minDistance)
     {
-      NodePtr_t closest = 0x0;
-      minDistance = std::numeric_limits<value_type>::infinity ();
-      for (ConnectedComponents_t::const_iterator itcc =
-	     connectedComponents_.begin ();
-	   itcc != connectedComponents_.end (); ++itcc) {
-	value_type distance;
-	NodePtr_t node;
-	node = nearestNeighbor_->search(configuration, *itcc, distance);
-	if (distance < minDistance) {
-	  minDistance = distance;
-	  closest = node;
-	}
-      }
+      NodePtr_t closest =
+	nearestNeighbor_->search (configuration, minDistance);
       return closest;
     }
 
@@ -182,11 +191,52 @@ namespace hpp {
 	nearestNeighbor_->search(configuration, connectedComponent, minDistance);
       return closest;
     }
+
+    void Roadmap::nearestNodes (const ConfigurationPtr_t& configuration,
+				NearestNodes_t& nearest)
+    {
+      nearestNeighbor_->search (configuration, nearest);
+    }
+
+    Nodes_t Roadmap::nearestNodes
+    (const ConfigurationPtr_t& configuration,
+     const ConnectedComponentPtr_t& connectedComponent, std::size_t k)
+    {
+      assert (connectedComponent);
+      return nearestNeighbor_->kNearest (configuration, connectedComponent, k);
+    }
+
+    Nodes_t Roadmap::nodesWithinBall
+    (const ConfigurationPtr_t& configuration,
+     const ConnectedComponentPtr_t& connectedComponent, value_type maxDistance)
+    {
+      assert (connectedComponent);
+      return nearestNeighbor_->withinRadius (configuration, connectedComponent,
+					     maxDistance);
+    }
     
     void Roadmap::addGoalNode (const ConfigurationPtr_t& config)
     {
       NodePtr_t node = addNode (config);
+      node->isGoal (true);
       goalNodes_.push_back (node);
+      if (!node->connectedComponent ()->canReachGoal ()) {
+	markCanReachGoal (node->connectedComponent ());
+      }
+    }
+
+    void Roadmap::resetGoalNodes ()
+    {
+      for (Nodes_t::const_iterator itNode = goalNodes_.begin ();
+	   itNode != goalNodes_.end (); ++itNode) {
+	(*itNode)->isGoal (false);
+      }
+      goalNodes_.clear ();
+      for (ConnectedComponents_t::const_iterator itcc =
+	     connectedComponents_.begin ();
+	   itcc != connectedComponents_.end (); ++itcc) {
+	(*itcc)->canReachGoal_ = false;
+      }
     }
     
     const DistancePtr_t& Roadmap::distance () const
@@ -225,14 +275,36 @@ namespace hpp {
     void Roadmap::connect (const ConnectedComponentPtr_t& cc1,
 			   const ConnectedComponentPtr_t& cc2)
     {
-      if (cc1->canReach (cc2)) return;
+      // Connected components are not merged when a single edge links them,
+      // they then form a directed acyclic graph. An edge between them
+      // either is already in the graph, or closes a cycle the connected
+      // components of which are merged, or is added to the graph. An edge
+      // implied by other edges is stored as well, which saves a search.
+      if (cc1 == cc2 || cc1->reachableTo_.count (cc2)) return;
+      // The new edge lets cc1 and the connected components that reach it
+      // reach a goal node.
+      bool reachesGoal = cc2->canReachGoal_ && !cc1->canReachGoal_;
       ConnectedComponents_t cc2Tocc1;
-      if (cc2->canReach (cc1, cc2Tocc1)) {
+      if (cc2->reachableTo_.empty () || cc1->reachableFrom_.empty ()) {
+	// cc2 cannot reach cc1, no search is needed.
+	cc1->reachableTo_.insert (cc2);
+	cc2->reachableFrom_.insert (cc1);
+      } else if (cc2->reachableTo_.count (cc1) &&
+		 (cc2->reachableTo_.size () == 1 ||
+		  cc1->reachableFrom_.size () == 1)) {
+	// The reverse edge is the only path from cc2 to cc1, the cycle is
+	// made of both connected components only. This is the usual case
+	// of an edge added in both directions.
+	cc2Tocc1.insert (cc1);
+	cc2Tocc1.insert (cc2);
+	merge (cc1, cc2Tocc1);
+      } else if (cc2->canReach (cc1, cc2Tocc1)) {
 	merge (cc1, cc2Tocc1);
       } else {
 	cc1->reachableTo_.insert (cc2);
 	cc2->reachableFrom_.insert (cc1);
       }
+      if (reachesGoal) markCanReachGoal (cc1);
     }
   
     void Roadmap::merge (const ConnectedComponentPtr_t& cc1,
@@ -242,6 +314,7 @@ namespace hpp {
 	   itcc != ccs.end (); ++itcc) {
 	if (*itcc != cc1) {
 	  cc1->merge (*itcc);
+	  nearestNeighbor_->merge (cc1, *itcc);
 #ifndef NDEBUG	  
 	  std::size_t nb =
 #endif
@@ -251,16 +324,30 @@ namespace hpp {
       }
     }
 
-    bool Roadmap::pathExists () const
+    void Roadmap::markCanReachGoal (const ConnectedComponentPtr_t& cc)
     {
-      const ConnectedComponentPtr_t ccInit = initNode ()->connectedComponent ();
-      for (Nodes_t::const_iterator itGoal = goalNodes_.begin ();
-	   itGoal != goalNodes_.end (); ++itGoal) {
-	if (ccInit->canReach ((*itGoal)->connectedComponent ())) {
-	  return true;
+      // Breadth first search backward, connected components already marked
+      // are not expanded since the ones that reach them are marked too.
+      std::vector <ConnectedComponent*> queue;
+      std::vector <ConnectedComponent*>::size_type head = 0;
+      cc->canReachGoal_ = true;
+      queue.push_back (cc.get ());
+      while (head < queue.size ()) {
+	ConnectedComponent* current = queue [head]; ++head;
+	for (ConnectedComponents_t::const_iterator itcc =
+	       current->reachableFrom_.begin ();
+	     itcc != current->reachableFrom_.end (); ++itcc) {
+	  if (!(*itcc)->canReachGoal_) {
+	    (*itcc)->canReachGoal_ = true;
+	    queue.push_back (itcc->get ());
+	  }
 	}
       }
-      return false;
+    }
+
+    bool Roadmap::pathExists () const
+    {
+      return initNode ()->connectedComponent ()->canReachGoal ();
     }
 
     std::ostream& Roadmap::print (std::ostream& os) const
@@ -21,6 +21,7 @@
 #include <hpp/model/joint.hh>
 #include <hpp/model/joint-configuration.hh>
 #include <hpp/core/config-projector.hh>
+#include <hpp/core/configuration-layout.hh>
 #include <hpp/core/straight-path.hh>
 #include <hpp/core/projection-error.hh>
 
@@ -32,7 +33,8 @@ namespace hpp {
 				value_type length) :
       parent_t (interval_t (0, length), device->configSize (),
 		device->numberDof ()),
-      device_ (device), initial_ (init), end_ (end)
+      device_ (device), layout_ (ConfigurationLayout::create (device)),
+      initial_ (init), end_ (end)
     {
       assert (device);
       assert (length >= 0);
@@ -46,7 +48,8 @@ namespace hpp {
 				ConstraintSetPtr_t constraints) :
       parent_t (interval_t (0, length), device->configSize (),
 		device->numberDof (), constraints),
-      device_ (device), initial_ (init), end_ (end)
+      device_ (device), layout_ (ConfigurationLayout::create (device)),
+      initial_ (init), end_ (end)
     {
       assert (device);
       assert (length >= 0);
@@ -58,16 +61,37 @@ namespace hpp {
       }
     }
 
+    StraightPath::StraightPath (const DevicePtr_t& device,
+				ConfigurationIn_t init,
+				ConfigurationIn_t end,
+				value_type length,
+				ConstraintSetPtr_t constraints,
+				const ConfigurationLayoutPtr_t& layout) :
+      parent_t (interval_t (0, length), device->configSize (),
+		device->numberDof (), constraints),
+      device_ (device), layout_ (layout), initial_ (init), end_ (end)
+    {
+      assert (device);
+      assert (layout);
+      assert (length >= 0);
+      assert (!constraints || constraints->isSatisfied (initial_));
+      if (constraints && !constraints->isSatisfied (end_)) {
+	hppDout (error, *constraints);
+	hppDout (error, end_.transpose ());
+	abort ();
+      }
+    }
+
     StraightPath::StraightPath (const StraightPath& path) :
-      parent_t (path), device_ (path.device_), initial_ (path.initial_),
-      end_ (path.end_)
+      parent_t (path), device_ (path.device_), layout_ (path.layout_),
+      initial_ (path.initial_), end_ (path.end_)
     {
     }
 
     StraightPath::StraightPath (const StraightPath& path,
 				const ConstraintSetPtr_t& constraints) :
       parent_t (path, constraints), device_ (path.device_),
-      initial_ (path.initial_), end_ (path.end_)
+      layout_ (path.layout_), initial_ (path.initial_), end_ (path.end_)
     {
       assert (constraints->apply (initial_));
       assert (constraints->apply (end_));
@@ -89,14 +113,7 @@ namespace hpp {
       value_type u = param/timeRange ().second;
       if (timeRange ().second == 0)
 	u = 0;
-      // Loop over device joint and interpolate
-      const JointVector_t& jv (device_->getJointVector ());
-      for (model::JointVector_t::const_iterator itJoint = jv.begin ();
-	   itJoint != jv.end (); ++itJoint) {
-	std::size_t rank = (*itJoint)->rankInConfiguration ();
-	(*itJoint)->configuration ()->interpolate
-	  (initial_, end_, u, rank, result);
-      }
+      layout_->interpolate (initial_, end_, u, result);
       return true;
     }
     PathPtr_t StraightPath::extract (const interval_t& subInterval) const
@@ -112,7 +129,7 @@ namespace hpp {
       if (!success) throw projection_error
 		      ("Failed to apply constraints in StraightPath::extract");
       PathPtr_t result = StraightPath::create (device_, q1, q2, l,
-					       constraints ());
+					       constraints (), layout_);
       return result;
     }
 
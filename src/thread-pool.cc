@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <cassert>
+#include <boost/bind.hpp>
+#include "thread-pool.hh"
+
+namespace hpp {
+  namespace core {
+    ThreadPool::ThreadPool (std::size_t size) :
+      size_ (size), threads_ (), mutex_ (), start_ (), done_ (), task_ (),
+      active_ (0), running_ (0), generation_ (0), stop_ (false)
+    {
+      for (std::size_t rank = 0; rank < size; ++rank) {
+	threads_.create_thread (boost::bind (&ThreadPool::work, this, rank));
+      }
+    }
+
+    ThreadPool::~ThreadPool ()
+    {
+      {
+	boost::mutex::scoped_lock lock (mutex_);
+	stop_ = true;
+	start_.notify_all ();
+      }
+      threads_.join_all ();
+    }
+
+    void ThreadPool::run (const Task_t& task, std::size_t n)
+    {
+      assert (n <= size_);
+      if (n == 0) return;
+      boost::mutex::scoped_lock lock (mutex_);
+      task_ = task;
+      active_ = n;
+      running_ = n;
+      ++generation_;
+      start_.notify_all ();
+      while (running_ > 0) done_.wait (lock);
+      task_.clear ();
+    }
+
+    void ThreadPool::work (std::size_t rank)
+    {
+      std::size_t generation = 0;
+      while (true) {
+	Task_t task;
+	{
+	  boost::mutex::scoped_lock lock (mutex_);
+	  while (!stop_ && generation_ == generation) start_.wait (lock);
+	  if (stop_) return;
+	  generation = generation_;
+	  // Workers that are not needed wait for the next task.
+	  if (rank >= active_) continue;
+	  task = task_;
+	}
+	task (rank);
+	boost::mutex::scoped_lock lock (mutex_);
+	if (--running_ == 0) done_.notify_all ();
+      }
+    }
+  } // namespace core
+} // namespace hpp
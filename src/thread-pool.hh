@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_THREAD_POOL_HH
+# define HPP_CORE_THREAD_POOL_HH
+
+# include <boost/function.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/thread.hpp>
+# include <hpp/core/fwd.hh>
+
+namespace hpp {
+  namespace core {
+    /// Fixed set of worker threads kept alive between calls to run
+    ///
+    /// Path planners validate a few paths at each step: creating threads
+    /// at each step would cost as much as the validation of short paths.
+    class ThreadPool
+    {
+    public:
+      /// Task run by a worker, the argument is the rank of the worker
+      ///
+      /// Tasks must not throw.
+      typedef boost::function <void (std::size_t)> Task_t;
+
+      /// Create a pool of workers
+      /// \param size number of worker threads.
+      static ThreadPoolPtr_t create (std::size_t size)
+      {
+	return ThreadPoolPtr_t (new ThreadPool (size));
+      }
+
+      /// Stop and join the workers
+      ~ThreadPool ();
+
+      /// Number of worker threads
+      std::size_t size () const
+      {
+	return size_;
+      }
+
+      /// Run task (i) in worker i for i in [0, n) and wait for all of them
+      /// \param task the task,
+      /// \param n number of workers running the task, at most size ().
+      void run (const Task_t& task, std::size_t n);
+
+    private:
+      ThreadPool (std::size_t size);
+      /// Loop of a worker thread
+      void work (std::size_t rank);
+
+      std::size_t size_;
+      boost::thread_group threads_;
+      boost::mutex mutex_;
+      /// Notified when a task is submitted or the pool is stopped
+      boost::condition_variable start_;
+      /// Notified when the last worker completes the task
+      boost::condition_variable done_;
+      Task_t task_;
+      /// Number of workers running the current task
+      std::size_t active_;
+      /// Number of workers that did not complete the current task yet
+      std::size_t running_;
+      /// Incremented at each call to run
+      std::size_t generation_;
+      bool stop_;
+    }; // class ThreadPool
+  } // namespace core
+} // namespace hpp
+#endif // HPP_CORE_THREAD_POOL_HH
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2026 CNRS
+// Authors: agent
+//
+// This file is part of hpp-core
+// hpp-core is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-core is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-core  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <sstream>
+#include <stdexcept>
+#include <hpp/model/device.hh>
+#include <hpp/model/joint.hh>
+#include <hpp/core/collision-validation.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/joint-bound-validation.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/validation-context.hh>
+
+namespace hpp {
+  namespace core {
+    ValidationContextPtr_t ValidationContext::create
+    (const DevicePtr_t& robot,
+     const PathValidationBuilder_t& pathValidationBuilder,
+     const value_type& tolerance)
+    {
+      return ValidationContextPtr_t
+	(new ValidationContext (robot, pathValidationBuilder, tolerance));
+    }
+
+    ValidationContext::ValidationContext
+    (const DevicePtr_t& robot,
+     const PathValidationBuilder_t& pathValidationBuilder,
+     const value_type& tolerance) :
+      original_ (robot), robot_ (robot->clone ()),
+      pathValidationBuilder_ (pathValidationBuilder), tolerance_ (tolerance),
+      configValidations_ (ConfigValidations::create ()),
+      pathValidation_ (pathValidationBuilder (robot_, tolerance)),
+      obstacles_ (), removedPairs_ ()
+    {
+      configValidations_->add (CollisionValidation::create (robot_));
+      configValidations_->add (JointBoundValidation::create (robot_));
+    }
+
+    ValidationContextPtr_t ValidationContext::clone () const
+    {
+      ValidationContextPtr_t result
+	(create (original_, pathValidationBuilder_, tolerance_));
+      for (ObjectVector_t::const_iterator itObj = obstacles_.begin ();
+	   itObj != obstacles_.end (); ++itObj) {
+	result->addObstacle (*itObj);
+      }
+      for (std::vector <std::pair <std::string, CollisionObjectPtr_t> >::
+	     const_iterator itPair = removedPairs_.begin ();
+	   itPair != removedPairs_.end (); ++itPair) {
+	result->removeObstacleFromJoint (itPair->first, itPair->second);
+      }
+      return result;
+    }
+
+    void ValidationContext::addObstacle (const CollisionObjectPtr_t& object)
+    {
+      obstacles_.push_back (object);
+      pathValidation_->addObstacle (object);
+      configValidations_->addObstacle (object);
+    }
+
+    void ValidationContext::removeObstacleFromJoint
+    (const JointPtr_t& joint, const CollisionObjectPtr_t& obstacle)
+    {
+      removeObstacleFromJoint (joint->name (), obstacle);
+    }
+
+    void ValidationContext::removeObstacleFromJoint
+    (const std::string& jointName, const CollisionObjectPtr_t& obstacle)
+    {
+      JointPtr_t joint = robot_->getJointByName (jointName);
+      if (!joint) {
+	std::ostringstream oss;
+	oss << "ValidationContext::removeObstacleFromJoint: no joint \""
+	    << jointName << "\" in the copy of the robot.";
+	throw std::runtime_error (oss.str ());
+      }
+      removedPairs_.push_back (std::make_pair (jointName, obstacle));
+      pathValidation_->removeObstacleFromJoint (joint, obstacle);
+      configValidations_->removeObstacleFromJoint (joint, obstacle);
+    }
+  } // namespace core
+} // namespace hpp
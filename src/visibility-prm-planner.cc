@@ -16,17 +16,23 @@
 // hpp-core  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+#include <boost/bind.hpp>
 #include <hpp/util/debug.hh>
 #include <hpp/model/device.hh>
 #include <hpp/model/configuration.hh>
 #include <hpp/core/config-projector.hh>
 #include <hpp/core/config-validations.hh>
 #include <hpp/core/connected-component.hh>
+#include <hpp/core/distance.hh>
+#include <hpp/core/node.hh>
 #include <hpp/core/path-validation.hh>
 #include <hpp/core/problem.hh>
 #include <hpp/core/roadmap.hh>
+#include <hpp/core/steering-method.hh>
 #include <hpp/core/visibility-prm-planner.hh>
 #include <hpp/core/basic-configuration-shooter.hh>
+#include "thread-pool.hh"
 
 #include <stdio.h>
 #include <time.h>
@@ -51,14 +57,16 @@ namespace hpp {
 
     VisibilityPrmPlanner::VisibilityPrmPlanner (const Problem& problem):
       PathPlanner (problem),
-      configurationShooter_ (problem.configurationShooter())
+      configurationShooter_ (problem.configurationShooter()),
+      pathValidations_ (), threadPool_ (), guards_ ()
     {
     }
 
     VisibilityPrmPlanner::VisibilityPrmPlanner (const Problem& problem,
 						const RoadmapPtr_t& roadmap) :
       PathPlanner (problem, roadmap),
-      configurationShooter_ (problem.configurationShooter())
+      configurationShooter_ (problem.configurationShooter()),
+      pathValidations_ (), threadPool_ (), guards_ ()
     {
     }
 
@@ -68,39 +76,55 @@ namespace hpp {
       weakPtr_ = weak;
     }
 
-    bool VisibilityPrmPlanner::visibleFromCC (const ConfigurationPtr_t q, 
-					      const ConnectedComponentPtr_t cc){
+    bool VisibilityPrmPlanner::isGuard (const NodePtr_t& node) const
+    {
+      return node->index () < guards_.size () && guards_ [node->index ()];
+    }
+
+    void VisibilityPrmPlanner::isGuard (const NodePtr_t& node, bool guard)
+    {
+      if (node->index () >= guards_.size ()) {
+	guards_.resize (node->index () + 1, false);
+      }
+      guards_ [node->index ()] = guard;
+    }
+
+    void VisibilityPrmPlanner::visibleFromCC
+    (const ConfigurationPtr_t q, VisibilityTask& task,
+     const PathValidationPtr_t& pathValidation) const
+    {
       PathPtr_t validPart;
-      bool found = false; 
-      value_type length = std::numeric_limits <value_type>::infinity ();
-      PathValidationPtr_t pathValidation (problem ().pathValidation ());
       SteeringMethodPtr_t sm (problem ().steeringMethod ());
-      RoadmapPtr_t r (roadmap ());
-      DelayedEdge_t delayedEdge;
-
-      for (Nodes_t::const_iterator n_it = cc->nodes ().begin (); 
-	   n_it != cc->nodes ().end (); ++n_it){
-	if(nodeStatus_ [*n_it]){// only iterate on guard nodes
-	  ConfigurationPtr_t qCC = (*n_it)->configuration ();
-	  PathPtr_t path = (*sm) (*q, *qCC);
-	  PathValidationReportPtr_t report;
-	  if (pathValidation->validate (path, false, validPart, report)){
-	    // q and qCC see each other
-	    if (path->length () < length) {
-	      length = path->length ();
-	      // Save shortest edge
-	      delayedEdge = DelayedEdge_t (*n_it, q, path->reverse ());
-	    }
-	    found = true;
-	  }
+      for (std::vector <std::pair <value_type, NodePtr_t> >::const_iterator
+	     itGuard = task.guards.begin (); itGuard != task.guards.end ();
+	   ++itGuard) {
+	ConfigurationPtr_t qCC = itGuard->second->configuration ();
+	PathPtr_t path = (*sm) (*q, *qCC);
+	if (!path) continue;
+	PathValidationReportPtr_t report;
+	if (pathValidation->validate (path, false, validPart, report)) {
+	  // q and qCC see each other
+	  task.guard = itGuard->second;
+	  task.path = path;
+	  return;
 	}
       }
-      if (found) {
-	// Store shortest delayed edge in list
-	delayedEdges_.push_back (delayedEdge);
-	return true;
+    }
+
+    void VisibilityPrmPlanner::visibleFromCCs
+    (const ConfigurationPtr_t q, VisibilityTasks_t* tasks, std::size_t thread,
+     std::size_t threads) const
+    {
+      const PathValidationPtr_t& pathValidation (pathValidations_ [thread]);
+      for (std::size_t i = thread; i < tasks->size (); i += threads) {
+	VisibilityTask& task ((*tasks) [i]);
+	// Exceptions cannot leave the thread, they are reported by oneStep.
+	try {
+	  visibleFromCC (q, task, pathValidation);
+	} catch (const std::exception& exc) {
+	  task.error = exc.what ();
+	}
       }
-      else return false;
     }
 
     ConfigurationPtr_t VisibilityPrmPlanner::applyConstraints 
@@ -133,10 +157,10 @@ namespace hpp {
 	(new Configuration_t (*(r->initNode ()->configuration ())));
 
       /* Initialization of guard status */
-      nodeStatus_ [r->initNode ()] = true; // init node is guard
+      isGuard (r->initNode (), true); // init node is guard
       for (Nodes_t::const_iterator itg = r->goalNodes ().begin();
 	   itg != r->goalNodes ().end (); ++itg) {
-	nodeStatus_ [*itg] = true; // goal nodes are guards
+	isGuard (*itg, true); // goal nodes are guards
       }
 
       // Shoot random config as long as not collision-free
@@ -150,19 +174,57 @@ namespace hpp {
 	       !constrApply_);
       count = 0;
 
+      // Guards of each connected component by increasing distance to q_rand
+      const DistancePtr_t& distance (problem ().distance ());
+      VisibilityTasks_t tasks;
       for (ConnectedComponents_t::const_iterator itcc =
 	     r->connectedComponents ().begin ();
 	   itcc != r->connectedComponents ().end (); ++itcc) {
-	ConnectedComponentPtr_t cc = *itcc;
-	if (visibleFromCC (q_rand, cc)) { 
-	  // delayedEdges_ will completed if visible
+	VisibilityTask task;
+	for (Nodes_t::const_iterator n_it = (*itcc)->nodes ().begin ();
+	     n_it != (*itcc)->nodes ().end (); ++n_it) {
+	  if (isGuard (*n_it)) { // only iterate on guard nodes
+	    task.guards.push_back (std::make_pair
+				   ((*distance) (*q_rand,
+						 *(*n_it)->configuration ()),
+				    *n_it));
+	  }
+	}
+	if (task.guards.empty ()) continue;
+	std::sort (task.guards.begin (), task.guards.end ());
+	tasks.push_back (task);
+      }
+      // Connected components are tested independently, in parallel if
+      // several path validation methods are available.
+      const ConstraintSetPtr_t& constraints
+	(problem ().steeringMethod ()->constraints ());
+      std::size_t threads = std::min (pathValidations_.size (), tasks.size ());
+      if (constraints && constraints->configProjector ()) threads = 0;
+      if (threads <= 1) {
+	PathValidationPtr_t pathValidation (problem ().pathValidation ());
+	for (VisibilityTasks_t::iterator itTask = tasks.begin ();
+	     itTask != tasks.end (); ++itTask) {
+	  visibleFromCC (q_rand, *itTask, pathValidation);
+	}
+      } else {
+	threadPool_->run (boost::bind (&VisibilityPrmPlanner::visibleFromCCs,
+				       this, q_rand, &tasks, _1, threads),
+			  threads);
+      }
+      for (VisibilityTasks_t::const_iterator itTask = tasks.begin ();
+	   itTask != tasks.end (); ++itTask) {
+	if (!itTask->error.empty ()) throw std::runtime_error (itTask->error);
+	if (itTask->guard) {
+	  // Store the edge from the nearest visible guard
+	  delayedEdges_.push_back (DelayedEdge_t (itTask->guard, q_rand,
+						  itTask->path->reverse ()));
 	  count++; // count how many times q has been seen
 	}
       }
-	
+
       if (count == 0){ // q not visible from anywhere
 	NodePtr_t newNode = r->addNode (q_rand); // add q as a guard node
-	nodeStatus_ [newNode] = true;
+	isGuard (newNode, true);
 	hppDout(info, "q is a guard node: " << displayConfig (*q_rand));
       }
       if (count > 1){ // q visible several times
@@ -173,7 +235,7 @@ namespace hpp {
 	  const ConfigurationPtr_t& q_new = itEdge-> get <1> ();
 	  const PathPtr_t& validPath = itEdge-> get <2> ();
 	  NodePtr_t newNode = r->addNode (q_new);
-	  nodeStatus_ [newNode] = false;
+	  isGuard (newNode, false);
 	  r->addEdge (near, newNode, validPath);
 	  interval_t timeRange = validPath->timeRange ();
 	  r->addEdge (newNode, near, validPath->extract
@@ -192,5 +254,15 @@ namespace hpp {
       configurationShooter_ = shooter;
     }
 
+    void VisibilityPrmPlanner::pathValidations
+    (const PathValidations_t& pathValidations)
+    {
+      pathValidations_ = pathValidations;
+      threadPool_.reset ();
+      if (pathValidations_.size () > 1) {
+	threadPool_ = ThreadPool::create (pathValidations_.size ());
+      }
+    }
+
   } // namespace core
 } // namespace hpp
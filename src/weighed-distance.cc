@@ -23,6 +23,7 @@
 #include <hpp/model/joint.hh>
 #include <hpp/model/joint-configuration.hh>
 #include <hpp/model/children-iterator.hh>
+#include <hpp/core/configuration-layout.hh>
 #include <hpp/core/weighed-distance.hh>
 #include <Eigen/SVD>
 
@@ -78,6 +79,7 @@ namespace hpp {
       if ( rank < weights_.size() ) 
       {
 	weights_[rank] = weight;
+	computeCoordinateWeights ();
       }
       else {
 	std::ostringstream oss;
@@ -88,7 +90,8 @@ namespace hpp {
     } 
 
     WeighedDistance::WeighedDistance (const DevicePtr_t& robot) :
-      robot_ (robot), weights_ ()
+      robot_ (robot), layout_ (ConfigurationLayout::create (robot)),
+      weights_ ()
     {
       // Store computation flag
       Device_t::Computation_t flag = robot->computationFlag ();
@@ -137,12 +140,13 @@ namespace hpp {
 
     WeighedDistance::WeighedDistance (const DevicePtr_t& robot,
 				      const std::vector <value_type>& weights) :
-      robot_ (robot), weights_ (weights)
+      robot_ (robot), layout_ (ConfigurationLayout::create (robot)),
+      weights_ (weights)
     {
     }
 
     WeighedDistance::WeighedDistance (const WeighedDistance& distance) :
-      robot_ (distance.robot_),
+      robot_ (distance.robot_), layout_ (distance.layout_),
       weights_ (distance.weights_)
     {
     }
@@ -150,25 +154,93 @@ namespace hpp {
     void WeighedDistance::init (WeighedDistanceWkPtr_t self)
     {
       weak_ = self;
+      computeCoordinateWeights ();
+    }
+
+    void WeighedDistance::computeCoordinateWeights ()
+    {
+      // The distance of translations and bounded rotations is the
+      // euclidean distance between their coordinates.
+      linearWeights_ = layout_->coordinateWeights (weights_).array ().
+	square ();
+      rotationJoints_.clear ();
+      so3Weights_.clear ();
+      so2Weights_.clear ();
+      const ConfigurationLayout::Rotations_t& rotations
+	(layout_->rotations ());
+      for (ConfigurationLayout::Rotations_t::const_iterator it =
+	     rotations.begin (); it != rotations.end (); ++it) {
+	const value_type weight2 = weights_ [it->index] * weights_ [it->index];
+	rotationJoints_.push_back (std::make_pair (it->joint, weight2));
+	if (it->type == ConfigurationLayout::SO3) {
+	  so3Weights_.push_back (std::make_pair (it->rank, weight2));
+	} else if (it->type == ConfigurationLayout::SO2) {
+	  so2Weights_.push_back (std::make_pair (it->rank, weight2));
+	}
+      }
+    }
+
+    void WeighedDistance::compute (ConfigurationIn_t q,
+				   const matrixIn_t& configurations,
+				   vectorOut_t distances) const
+    {
+      assert (distances.size () == configurations.cols ());
+      const size_type n = linearWeights_.size ();
+      matrix_t differences (configurations.topRows (n).colwise () -
+			    q.head (n));
+      distances.noalias () = differences.array ().square ().matrix ().
+	transpose () * linearWeights_;
+      for (std::vector <std::pair <JointPtr_t, value_type> >::const_iterator
+	     it = rotationJoints_.begin (); it != rotationJoints_.end ();
+	   ++it) {
+	const size_type rank = it->first->rankInConfiguration ();
+	for (size_type i = 0; i < configurations.cols (); ++i) {
+	  value_type distance = it->first->configuration ()->distance
+	    (q, configurations.col (i), rank);
+	  distances [i] += it->second * distance * distance;
+	}
+      }
+      distances = distances.array ().sqrt ();
+    }
+
+    value_type WeighedDistance::lowerBound (ConfigurationIn_t q1,
+					    ConfigurationIn_t q2) const
+    {
+      const size_type n = linearWeights_.size ();
+      value_type res = (linearWeights_.array () *
+			(q1.head (n) - q2.head (n)).array ().square ()).sum ();
+      // The squared chord between the (cos, sin) pairs of unbounded
+      // rotations is not greater than the squared angle.
+      for (std::vector <std::pair <size_type, value_type> >::const_iterator
+	     it = so2Weights_.begin (); it != so2Weights_.end (); ++it) {
+	res += it->second * (q1.segment (it->first, 2) -
+			     q2.segment (it->first, 2)).squaredNorm ();
+      }
+      // The squared chord 2 (1 - |q1.q2|) between unit quaternions is not
+      // greater than the squared angle between the rotations.
+      for (std::vector <std::pair <size_type, value_type> >::const_iterator
+	     it = so3Weights_.begin (); it != so3Weights_.end (); ++it) {
+	value_type chord2 = 2 * (1 - fabs (q1.segment (it->first, 4).dot
+					   (q2.segment (it->first, 4))));
+	if (chord2 > 0) res += it->second * chord2;
+      }
+      return sqrt (res);
     }
 
     value_type WeighedDistance::impl_distance (ConfigurationIn_t q1,
 					       ConfigurationIn_t q2) const
     {
-      // Loop over robot joint and interpolate
-      value_type res = 0;
-      std::size_t i=0;
-      const JointVector_t jointVector (robot_->getJointVector ());
-      for (JointVector_t::const_iterator itJoint = jointVector.begin ();
-	   itJoint != jointVector.end (); ++itJoint) {
-	if ((*itJoint)->numberDof () != 0) {
-	  value_type length = weights_ [i];
-	  value_type distance =
-	    (*itJoint)->configuration ()->distance
-	    (q1, q2, (*itJoint)->rankInConfiguration ());
-	  res += length * length * distance * distance;
-	  ++i;
-	}
+      // Vector space joints are handled by the coordinate weights, only
+      // rotation joints require a call per joint.
+      const size_type n = linearWeights_.size ();
+      value_type res = (linearWeights_.array () *
+			(q1.head (n) - q2.head (n)).array ().square ()).sum ();
+      for (std::vector <std::pair <JointPtr_t, value_type> >::const_iterator
+	     it = rotationJoints_.begin (); it != rotationJoints_.end ();
+	   ++it) {
+	value_type distance = it->first->configuration ()->distance
+	  (q1, q2, it->first->rankInConfiguration ());
+	res += it->second * distance * distance;
       }
       return sqrt (res);
     }
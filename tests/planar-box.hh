@@ -0,0 +1,65 @@
+// Copyright (C) 2026 LAAS-CNRS
+// Author: agent
+//
+// This file is part of the hpp-core.
+//
+// hpp-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_CORE_TESTS_PLANAR_BOX_HH
+# define HPP_CORE_TESTS_PLANAR_BOX_HH
+
+# include <hpp/fcl/math/transform.h>
+# include <hpp/fcl/shape/geometric_shapes.h>
+
+# include <hpp/model/body.hh>
+# include <hpp/model/collision-object.hh>
+# include <hpp/model/device.hh>
+# include <hpp/model/joint.hh>
+# include <hpp/model/object-factory.hh>
+
+// Small box translating in the plane, in [-3,3]x[-3,3]
+inline hpp::model::DevicePtr_t createRobot ()
+{
+  using namespace hpp::model;
+  DevicePtr_t robot = Device::create ("planar-box");
+  Transform3f position; position.setIdentity ();
+  ObjectFactory factory;
+  JointPtr_t root = factory.createJointTranslation2 (position);
+  root->name ("root");
+  for (std::size_t i = 0; i < 2; ++i) {
+    root->isBounded (i, true);
+    root->lowerBound (i, -3);
+    root->upperBound (i, 3);
+  }
+  robot->rootJoint (root);
+  boost::shared_ptr <fcl::Box> box (new fcl::Box (.2, .2, .2));
+  CollisionObjectPtr_t object = CollisionObject::create (box, position,
+							 "box");
+  BodyPtr_t body = new Body ();
+  body->name ("body");
+  root->setLinkedBody (body);
+  body->addInnerObject (object, true, true);
+  return robot;
+}
+
+// Wall across the x axis, between x = -.25 and x = .25
+inline hpp::model::CollisionObjectPtr_t createWall ()
+{
+  using namespace hpp::model;
+  Transform3f position; position.setIdentity ();
+  boost::shared_ptr <fcl::Box> box (new fcl::Box (.5, 3, 1));
+  return CollisionObject::create (box, position, "wall");
+}
+
+#endif // HPP_CORE_TESTS_PLANAR_BOX_HH
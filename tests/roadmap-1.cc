@@ -280,6 +280,13 @@ BOOST_AUTO_TEST_CASE (Roadmap1) {
   BOOST_CHECK (r->pathExists ());
   std::cout << *r << std::endl;
 
+  // goal reachability is reset with the goal nodes
+  r->resetGoalNodes ();
+  BOOST_CHECK (!r->pathExists ());
+  BOOST_CHECK (!nodes [5]->isGoal ());
+  r->addGoalNode (nodes [3]->configuration ());
+  BOOST_CHECK (r->pathExists ());
+  BOOST_CHECK (nodes [3]->isGoal ());
 }
 BOOST_AUTO_TEST_SUITE_END()
 
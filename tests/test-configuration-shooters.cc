@@ -0,0 +1,168 @@
+// Copyright (C) 2026 LAAS-CNRS
+// Author: agent
+//
+// This file is part of the hpp-core.
+//
+// hpp-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE configuration_shooters
+
+#include <cmath>
+#include <vector>
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/math/transform.h>
+
+#include <hpp/model/device.hh>
+#include <hpp/model/joint.hh>
+#include <hpp/model/object-factory.hh>
+
+#include <hpp/core/config-projector.hh>
+#include <hpp/core/constrained-configuration-shooter.hh>
+#include <hpp/core/constraint-set.hh>
+#include <hpp/core/halton-configuration-shooter.hh>
+#include <hpp/core/locked-joint.hh>
+#include <hpp/core/random-engine.hh>
+
+using hpp::model::Device;
+using hpp::model::DevicePtr_t;
+using hpp::model::JointPtr_t;
+using hpp::model::ObjectFactory;
+using hpp::model::Transform3f;
+
+using namespace hpp::core;
+
+// Planar translation, unbounded rotation and SO(3) joint
+DevicePtr_t createRobot ()
+{
+  DevicePtr_t robot = Device::create ("robot");
+  Transform3f position; position.setIdentity ();
+  ObjectFactory factory;
+  JointPtr_t root = factory.createJointTranslation2 (position);
+  root->name ("root");
+  root->isBounded (0, true);
+  root->lowerBound (0, -3);
+  root->upperBound (0, 3);
+  root->isBounded (1, true);
+  root->lowerBound (1, -1);
+  root->upperBound (1, 2);
+  robot->rootJoint (root);
+  JointPtr_t rotation = factory.createUnBoundedJointRotation (position);
+  rotation->name ("rotation");
+  root->addChildJoint (rotation);
+  JointPtr_t so3 = factory.createJointSO3 (position);
+  so3->name ("so3");
+  rotation->addChildJoint (so3);
+  return robot;
+}
+
+// Check that a configuration lies in the configuration space of the robot
+void checkBounds (const DevicePtr_t& robot, ConfigurationIn_t q)
+{
+  JointPtr_t root = robot->getJointByName ("root");
+  for (std::size_t i = 0; i < 2; ++i) {
+    value_type x = q [root->rankInConfiguration () + i];
+    BOOST_CHECK (x >= root->lowerBound (i) && x <= root->upperBound (i));
+  }
+  size_type rank = robot->getJointByName ("rotation")->rankInConfiguration ();
+  BOOST_CHECK_CLOSE (q.segment (rank, 2).norm (), 1., 1e-8);
+  rank = robot->getJointByName ("so3")->rankInConfiguration ();
+  BOOST_CHECK_CLOSE (q.segment (rank, 4).norm (), 1., 1e-8);
+}
+
+BOOST_AUTO_TEST_SUITE( test_hpp_core )
+
+BOOST_AUTO_TEST_CASE (halton)
+{
+  DevicePtr_t robot = createRobot ();
+  HaltonConfigurationShooterPtr_t shooter
+    (HaltonConfigurationShooter::create (robot));
+  shooter->randomEngine (RandomEngine::create (7));
+  const size_type n = 100;
+  matrix_t configurations (robot->configSize (), n);
+  for (size_type i = 0; i < n; ++i) {
+    ConfigurationPtr_t q = shooter->shoot ();
+    checkBounds (robot, *q);
+    configurations.col (i) = *q;
+  }
+  // The same sequence is drawn again after reset with the same seed, by
+  // shoot as well as by shootBatch.
+  shooter->reset ();
+  shooter->randomEngine ()->seed (7);
+  for (size_type i = 0; i < n; ++i) {
+    BOOST_CHECK (*shooter->shoot () == configurations.col (i));
+  }
+  shooter->reset ();
+  shooter->randomEngine ()->seed (7);
+  matrix_t batch (robot->configSize (), n);
+  shooter->shootBatch (n, batch);
+  BOOST_CHECK (batch == configurations);
+}
+
+BOOST_AUTO_TEST_CASE (constrained)
+{
+  DevicePtr_t robot = createRobot ();
+  JointPtr_t rotation = robot->getJointByName ("rotation");
+  vector_t value (2);
+  value << cos (.3), sin (.3);
+  ConfigProjectorPtr_t projector
+    (ConfigProjector::create (robot, "projector", 1e-4, 20));
+  projector->add (LockedJoint::create (rotation, value));
+  ConstraintSetPtr_t constraints (ConstraintSet::create (robot,
+							 "constraints"));
+  constraints->addConstraint (projector);
+
+  ConstrainedConfigurationShooterPtr_t shooter
+    (ConstrainedConfigurationShooter::create (robot, constraints));
+  // Only the coordinates of the translation are free vector coordinates.
+  BOOST_CHECK_EQUAL (shooter->numberFreeCoordinates (), 2u);
+  const size_type rank = rotation->rankInConfiguration ();
+  for (std::size_t i = 0; i < 100; ++i) {
+    ConfigurationPtr_t q = shooter->shoot ();
+    checkBounds (robot, *q);
+    BOOST_CHECK (q->segment (rank, 2) == value);
+  }
+  matrix_t batch (robot->configSize (), 10);
+  shooter->shootBatch (10, batch);
+  for (size_type i = 0; i < 10; ++i) {
+    checkBounds (robot, batch.col (i));
+    BOOST_CHECK (batch.col (i).segment (rank, 2) == value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE (constrainedFreeRotation)
+{
+  DevicePtr_t robot = createRobot ();
+  JointPtr_t root = robot->getJointByName ("root");
+  vector_t value (2);
+  value << 1., .5;
+  ConfigProjectorPtr_t projector
+    (ConfigProjector::create (robot, "projector", 1e-4, 20));
+  projector->add (LockedJoint::create (root, value));
+  ConstraintSetPtr_t constraints (ConstraintSet::create (robot,
+							 "constraints"));
+  constraints->addConstraint (projector);
+
+  ConstrainedConfigurationShooterPtr_t shooter
+    (ConstrainedConfigurationShooter::create (robot, constraints));
+  // Both rotations are free but are not vector coordinates.
+  BOOST_CHECK_EQUAL (shooter->numberFreeCoordinates (), 0u);
+  const size_type rank = root->rankInConfiguration ();
+  for (std::size_t i = 0; i < 100; ++i) {
+    ConfigurationPtr_t q = shooter->shoot ();
+    checkBounds (robot, *q);
+    BOOST_CHECK (q->segment (rank, 2) == value);
+  }
+}
+BOOST_AUTO_TEST_SUITE_END()
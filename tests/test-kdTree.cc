@@ -36,7 +36,9 @@
 #include <hpp/core/steering-method-straight.hh>
 #include <hpp/model/joint-configuration.hh>
 #include "../src/nearest-neighbor/basic.hh"
+#include "../src/nearest-neighbor/k-d-forest.hh"
 #include "../src/nearest-neighbor/k-d-tree.hh"
+#include "../src/nearest-neighbor/vp-tree.hh"
 
 
 #define BOOST_TEST_MODULE kdTree
@@ -72,7 +74,8 @@ BOOST_AUTO_TEST_CASE (kdTree) {
   // Build Distance, nearestNeighbor, KDTree
   WeighedDistancePtr_t distance = WeighedDistance::create(robot);
   BasicConfigurationShooterPtr_t confShoot = BasicConfigurationShooter::create(robot);
-  nearestNeighbor::KDTree kdTree(robot,distance,30);
+  NearestNeighborPtr_t kdTree (new nearestNeighbor::KDTree
+			       (robot, distance, 30));
   nearestNeighbor::Basic basic (distance);
   SteeringMethodPtr_t sm = SteeringMethodStraight::create (robot);
 
@@ -81,7 +84,7 @@ BOOST_AUTO_TEST_CASE (kdTree) {
   NodePtr_t node;
   NodePtr_t rootNode [4];
   RoadmapPtr_t roadmap = Roadmap::create (distance, robot);
-  roadmap->nearestNeighbor(&kdTree);
+  roadmap->nearestNeighbor(kdTree);
   for ( int i=0 ; i<4 ; i++ ) {
     configuration = confShoot->shoot();
     rootNode [i] = roadmap->addNode (configuration);
@@ -90,9 +93,13 @@ BOOST_AUTO_TEST_CASE (kdTree) {
       PathPtr_t path = (*sm) (*(rootNode [i]->configuration ()),
 			      *configuration);
       node = roadmap->addNodeAndEdges (rootNode [i], configuration, path);
-      basic.addNode (node);
     }
   }
+  // The structures built outside of the roadmap read the configurations of
+  // the nodes from a copy of the matrix of the roadmap.
+  matrix_t configurations (roadmap->configurations ());
+  basic.configurations (configurations);
+  basic.build (roadmap->nodes ());
 
   // search nearest node
   value_type minDistance1;
@@ -111,10 +118,123 @@ BOOST_AUTO_TEST_CASE (kdTree) {
 				    minDistance2);
       BOOST_CHECK( node1 == node2 );
       BOOST_CHECK( minDistance1 == minDistance2 );
+      // the lower bound used to screen nodes holds with rotations
+      BOOST_CHECK (distance->lowerBound (*configuration,
+					 *(node1->configuration ())) <=
+		   minDistance1 + 1e-10);
       std::cout << displayConfig (*(node1->configuration ())) << std::endl;
       std::cout << minDistance1 << std::endl;
     }
   }
+
+  // distances to all the nodes computed in a batch
+  vector_t distances (roadmap->nodes ().size ());
+  distance->compute (*configuration, roadmap->configurations (), distances);
+  for (Nodes_t::const_iterator itNode = roadmap->nodes ().begin ();
+       itNode != roadmap->nodes ().end (); ++itNode) {
+    BOOST_CHECK_CLOSE (distances [(*itNode)->index ()],
+		       (*distance) (*configuration,
+				    *((*itNode)->configuration ())), 1e-8);
+  }
+
+  // build a tree from the nodes of the roadmap in parallel and compare
+  nearestNeighbor::KDTree bulkTree (robot, distance, 30);
+  bulkTree.configurations (configurations);
+  bulkTree.buildThreads (4);
+  bulkTree.build (roadmap->nodes ());
+  for ( int j=0 ; j<50 ; j++ ) {
+    configuration = confShoot->shoot();
+    for ( int i=0 ; i<4 ; i++ ) {
+      node1 = basic.search (configuration, rootNode [i]->connectedComponent (),
+			    minDistance1);
+      node2 = bulkTree.search (configuration,
+			       rootNode [i]->connectedComponent (),
+			       minDistance2);
+      BOOST_CHECK( node1 == node2 );
+      BOOST_CHECK( minDistance1 == minDistance2 );
+    }
+  }
+
+  // randomized trees return approximate nearest nodes, measure the
+  // proportion of exact answers.
+  nearestNeighbor::KDForest kdForest (robot, distance, 4, 30);
+  kdForest.configurations (configurations);
+  kdForest.build (roadmap->nodes ());
+  kdForest.checks (256);
+  std::size_t exact = 0;
+  for ( int j=0 ; j<200 ; j++ ) {
+    configuration = confShoot->shoot();
+    node1 = roadmap->nearestNode (configuration, minDistance1);
+    node2 = kdForest.search (configuration, minDistance2);
+    BOOST_CHECK (minDistance2 >= minDistance1);
+    if (node1 == node2) ++exact;
+    NearestNodes_t nearest;
+    kdForest.search (configuration, nearest);
+    BOOST_CHECK_EQUAL (nearest.size (), 4);
+  }
+  value_type recall = (value_type) exact / 200.;
+  BOOST_TEST_MESSAGE ("KDForest recall with " << kdForest.checks ()
+		      << " checks: " << recall);
+  BOOST_CHECK (recall > .5);
+
+  // vantage point tree handles rotations through the distance only
+  nearestNeighbor::VPTree vpTree (distance, 30);
+  vpTree.configurations (configurations);
+  for (Nodes_t::const_iterator itNode = roadmap->nodes ().begin ();
+       itNode != roadmap->nodes ().end (); ++itNode) {
+    vpTree.addNode (*itNode);
+  }
+  for ( int j=0 ; j<50 ; j++ ) {
+    configuration = confShoot->shoot();
+    for ( int i=0 ; i<4 ; i++ ) {
+      const ConnectedComponentPtr_t& cc = rootNode [i]->connectedComponent ();
+      node1 = basic.search (configuration, cc, minDistance1);
+      node2 = vpTree.search (configuration, cc, minDistance2);
+      BOOST_CHECK( node1 == node2 );
+      BOOST_CHECK( minDistance1 == minDistance2 );
+      BOOST_CHECK (basic.kNearest (configuration, cc, 10) ==
+		   vpTree.kNearest (configuration, cc, 10));
+    }
+  }
+
+  // search k nearest nodes and nodes within a ball
+  for ( int j=0 ; j<50 ; j++ ) {
+    configuration = confShoot->shoot();
+    for ( int i=0 ; i<4 ; i++ ) {
+      const ConnectedComponentPtr_t& cc = rootNode [i]->connectedComponent ();
+      Nodes_t nodes1 = basic.kNearest (configuration, cc, 10);
+      Nodes_t nodes2 = roadmap->nearestNodes (configuration, cc, 10);
+      BOOST_CHECK_EQUAL (nodes1.size (), 10);
+      BOOST_CHECK (nodes1 == nodes2);
+      value_type radius = (*distance) (*configuration,
+				       *(nodes1.back ()->configuration ()));
+      nodes1 = basic.withinRadius (configuration, cc, radius);
+      nodes2 = roadmap->nodesWithinBall (configuration, cc, radius);
+      BOOST_CHECK_EQUAL (nodes1.size (), 10);
+      BOOST_CHECK (nodes1 == nodes2);
+    }
+  }
+
+  // merge the two first connected components and search nearest node of
+  // each connected component
+  PathPtr_t path = (*sm) (*(rootNode [0]->configuration ()),
+			  *(rootNode [1]->configuration ()));
+  roadmap->addEdge (rootNode [0], rootNode [1], path);
+  roadmap->addEdge (rootNode [1], rootNode [0], path->reverse ());
+  BOOST_CHECK (rootNode [0]->connectedComponent () ==
+	       rootNode [1]->connectedComponent ());
+  for ( int j=0 ; j<50 ; j++ ) {
+    configuration = confShoot->shoot();
+    NearestNodes_t nearest;
+    roadmap->nearestNodes (configuration, nearest);
+    BOOST_CHECK_EQUAL (nearest.size (), 3);
+    for ( int i=0 ; i<4 ; i++ ) {
+      const ConnectedComponentPtr_t& cc = rootNode [i]->connectedComponent ();
+      node1 = basic.search (configuration, cc, minDistance1);
+      BOOST_CHECK (node1 == nearest [cc].first);
+      BOOST_CHECK (minDistance1 == nearest [cc].second);
+    }
+  }
 }
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,185 @@
+// Copyright (C) 2026 LAAS-CNRS
+// Author: agent
+//
+// This file is part of the hpp-core.
+//
+// hpp-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE path_planners
+
+#include <limits>
+#include <stdexcept>
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/core/bi-rrt-planner.hh>
+#include <hpp/core/diffusing-planner.hh>
+#include <hpp/core/lazy-prm-planner.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/path-vector.hh>
+#include <hpp/core/prm-star-planner.hh>
+#include <hpp/core/problem-solver.hh>
+#include <hpp/core/problem.hh>
+#include <hpp/core/random-engine.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/visibility-prm-planner.hh>
+
+#include "planar-box.hh"
+
+using namespace hpp::core;
+
+// The wall lies between the initial and the goal configurations: the
+// direct path is in collision, so the planners need to take steps.
+void initProblem (Problem& problem)
+{
+  problem.addObstacle (createWall ());
+  ConfigurationPtr_t qInit (new Configuration_t (2));
+  ConfigurationPtr_t qGoal (new Configuration_t (2));
+  (*qInit) << -2, 0;
+  (*qGoal) << 2, 0;
+  problem.initConfig (qInit);
+  problem.addGoalConfig (qGoal);
+}
+
+void checkPath (const Problem& problem, const PathVectorPtr_t& path)
+{
+  BOOST_REQUIRE (path);
+  BOOST_CHECK ((path->initial () - *problem.initConfig ()).norm () < 1e-10);
+  BOOST_CHECK ((path->end () - *problem.goalConfigs ().front ()).norm ()
+	       < 1e-10);
+  PathPtr_t validPart;
+  PathValidationReportPtr_t report;
+  BOOST_CHECK (problem.pathValidation ()->validate (path, false, validPart,
+						    report));
+}
+
+// Check that two planners built the same roadmap
+void checkSameRoadmaps (const RoadmapPtr_t& r1, const RoadmapPtr_t& r2)
+{
+  BOOST_REQUIRE_EQUAL (r1->configurations ().cols (),
+		       r2->configurations ().cols ());
+  BOOST_CHECK (r1->configurations () == r2->configurations ());
+  BOOST_CHECK_EQUAL (r1->edges ().size (), r2->edges ().size ());
+}
+
+// Solve with a diffusing planner validating paths with n threads
+RoadmapPtr_t solveDiffusing (std::size_t n)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  problem.randomEngine ()->seed (1);
+  DiffusingPlannerPtr_t planner (DiffusingPlanner::create (problem));
+  planner->pathValidations (problem.pathValidations (n));
+  checkPath (problem, planner->solve ());
+  return planner->roadmap ();
+}
+
+// Solve with a visibility PRM planner validating paths with n threads
+RoadmapPtr_t solveVisibilityPrm (std::size_t n)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  problem.randomEngine ()->seed (1);
+  VisibilityPrmPlannerPtr_t planner (VisibilityPrmPlanner::create (problem));
+  planner->pathValidations (problem.pathValidations (n));
+  checkPath (problem, planner->solve ());
+  return planner->roadmap ();
+}
+
+BOOST_AUTO_TEST_SUITE( test_hpp_core )
+
+BOOST_AUTO_TEST_CASE (lazyPrm)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  PathPlannerPtr_t planner (LazyPrmPlanner::create (problem));
+  checkPath (problem, planner->solve ());
+}
+
+BOOST_AUTO_TEST_CASE (biRrt)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  PathPlannerPtr_t planner (BiRRTPlanner::create (problem));
+  checkPath (problem, planner->solve ());
+}
+
+BOOST_AUTO_TEST_CASE (prmStar)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  PrmStarPlannerPtr_t planner (PrmStarPlanner::create (problem));
+  checkPath (problem, planner->solve ());
+  // With a budget, the planner keeps improving the path.
+  PathVectorPtr_t path
+    (planner->solve (std::numeric_limits <value_type>::infinity (), 200));
+  checkPath (problem, path);
+  BOOST_REQUIRE (planner->bestPath ());
+  BOOST_CHECK_EQUAL (planner->bestCost (), planner->bestPath ()->length ());
+}
+
+BOOST_AUTO_TEST_CASE (budget)
+{
+  Problem problem (createRobot ());
+  initProblem (problem);
+  PathPlannerPtr_t planner (BiRRTPlanner::create (problem));
+  // The direct path is in collision and no step is allowed.
+  BOOST_CHECK_THROW
+    (planner->solve (std::numeric_limits <value_type>::infinity (), 0),
+     std::runtime_error);
+  BOOST_CHECK_THROW
+    (planner->solve (0, std::numeric_limits <std::size_t>::max ()),
+     std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE (diffusingParallel)
+{
+  // Validating paths in parallel does not change the roadmap.
+  checkSameRoadmaps (solveDiffusing (1), solveDiffusing (3));
+}
+
+BOOST_AUTO_TEST_CASE (visibilityPrmParallel)
+{
+  checkSameRoadmaps (solveVisibilityPrm (1), solveVisibilityPrm (3));
+}
+
+BOOST_AUTO_TEST_CASE (portfolio)
+{
+  ProblemSolverPtr_t problemSolver = ProblemSolver::create ();
+  problemSolver->robot (createRobot ());
+  problemSolver->addObstacle (createWall (), true, true);
+  ConfigurationPtr_t qInit (new Configuration_t (2));
+  ConfigurationPtr_t qGoal (new Configuration_t (2));
+  (*qInit) << -2, 0;
+  (*qGoal) << 2, 0;
+  problemSolver->initConfig (qInit);
+  problemSolver->addGoalConfig (qGoal);
+  ProblemSolver::PathPlannerTypes_t types;
+  types.push_back ("BiRRTPlanner");
+  types.push_back ("LazyPrmPlanner");
+  types.push_back ("DiffusingPlanner");
+  problemSolver->solvePortfolio (types, 60,
+				 std::numeric_limits <std::size_t>::max ());
+  BOOST_REQUIRE_EQUAL (problemSolver->paths ().size (), 1u);
+  problemSolver->problem ()->initConfig (qInit);
+  problemSolver->problem ()->addGoalConfig (qGoal);
+  checkPath (*problemSolver->problem (), problemSolver->paths ().back ());
+
+  // Path planners of solve validate paths in parallel.
+  problemSolver->numberOfThreads (2);
+  problemSolver->solve ();
+  BOOST_REQUIRE_EQUAL (problemSolver->paths ().size (), 2u);
+  checkPath (*problemSolver->problem (), problemSolver->paths ().back ());
+  delete problemSolver;
+}
+BOOST_AUTO_TEST_SUITE_END()
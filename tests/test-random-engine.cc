@@ -0,0 +1,53 @@
+// Copyright (C) 2026 LAAS-CNRS
+// Author: agent
+//
+// This file is part of the hpp-core.
+//
+// hpp-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <hpp/core/random-engine.hh>
+
+#define BOOST_TEST_MODULE randomEngine
+#include <boost/test/included/unit_test.hpp>
+
+using namespace hpp;
+using namespace core;
+
+BOOST_AUTO_TEST_SUITE( test_hpp_core )
+
+BOOST_AUTO_TEST_CASE (randomEngine) {
+  RandomEnginePtr_t e1 = RandomEngine::create (42);
+  RandomEnginePtr_t e2 = RandomEngine::create (42);
+  for (std::size_t i = 0; i < 100; ++i) {
+    value_type u = e1->uniform ();
+    BOOST_CHECK (u >= 0 && u < 1);
+    BOOST_CHECK_EQUAL (u, e2->uniform ());
+    std::size_t k = e1->uniformInt (7);
+    BOOST_CHECK (k < 7);
+    BOOST_CHECK_EQUAL (k, e2->uniformInt (7));
+  }
+  // Reseeding restarts the sequence
+  value_type first = RandomEngine::create (42)->uniform ();
+  e1->seed (42);
+  BOOST_CHECK_EQUAL (e1->uniform (), first);
+
+  // Streams only depend on the seed and on their index
+  RandomEnginePtr_t s0 = e1->stream (0);
+  RandomEnginePtr_t s1 = e1->stream (1);
+  BOOST_CHECK_EQUAL (s0->seed (), e2->stream (0)->seed ());
+  BOOST_CHECK (s0->seed () != s1->seed ());
+  BOOST_CHECK (s0->seed () != e1->seed ());
+  BOOST_CHECK (s0->uniform () != s1->uniform ());
+}
+BOOST_AUTO_TEST_SUITE_END()
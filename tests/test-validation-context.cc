@@ -0,0 +1,149 @@
+// Copyright (C) 2026 LAAS-CNRS
+// Author: agent
+//
+// This file is part of the hpp-core.
+//
+// hpp-core is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// test-hpp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with hpp-core.  If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE validation_context
+
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <hpp/core/basic-configuration-shooter.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/problem.hh>
+#include <hpp/core/steering-method.hh>
+#include <hpp/core/validation-context.hh>
+
+#include "planar-box.hh"
+
+using namespace hpp::core;
+
+bool validate (const DevicePtr_t& robot,
+	       const ConfigValidationsPtr_t& configValidations,
+	       ConfigurationIn_t q)
+{
+  ValidationReportPtr_t report;
+  robot->currentConfiguration (q);
+  robot->computeForwardKinematics ();
+  return configValidations->validate (q, report);
+}
+
+// Validate paths with the path validation method of a context
+void validatePaths (const ValidationContextPtr_t& context,
+		    const std::vector <PathPtr_t>* paths,
+		    std::vector <int>* verdicts)
+{
+  const PathValidationPtr_t& pathValidation (context->pathValidation ());
+  for (std::size_t i = 0; i < paths->size (); ++i) {
+    PathPtr_t validPart;
+    PathValidationReportPtr_t report;
+    (*verdicts) [i] = pathValidation->validate ((*paths) [i], false,
+						validPart, report);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE( test_hpp_core )
+
+BOOST_AUTO_TEST_CASE (sameVerdicts)
+{
+  DevicePtr_t robot = createRobot ();
+  Problem problem (robot);
+  problem.addObstacle (createWall ());
+  ValidationContextPtr_t context
+    (problem.validationContexts (1).front ()->clone ());
+  BOOST_CHECK (context->robot () != robot);
+
+  BasicConfigurationShooterPtr_t shooter
+    (BasicConfigurationShooter::create (robot));
+  Configuration_t q0 (2);
+  q0 << -2, 0;
+  std::size_t collisions = 0;
+  for (std::size_t i = 0; i < 200; ++i) {
+    ConfigurationPtr_t q = shooter->shoot ();
+    bool valid = validate (robot, problem.configValidations (), *q);
+    BOOST_CHECK_EQUAL (validate (context->robot (),
+				 context->configValidations (), *q), valid);
+    if (!valid) ++collisions;
+    PathPtr_t path = (*problem.steeringMethod ()) (q0, *q);
+    PathPtr_t validPart;
+    PathValidationReportPtr_t report;
+    valid = problem.pathValidation ()->validate (path, false, validPart,
+						 report);
+    BOOST_CHECK_EQUAL (context->pathValidation ()->validate
+		       (path, false, validPart, report), valid);
+  }
+  // The wall is hit by some configurations.
+  BOOST_CHECK (collisions > 0);
+}
+
+BOOST_AUTO_TEST_CASE (removedPairs)
+{
+  DevicePtr_t robot = createRobot ();
+  Problem problem (robot);
+  CollisionObjectPtr_t wall (createWall ());
+  problem.addObstacle (wall);
+  Configuration_t q (2);
+  q << 0, 0;
+  BOOST_CHECK (!validate (robot, problem.configValidations (), q));
+  // Collision pairs removed before the contexts are created are removed
+  // from the contexts too.
+  problem.removeObstacleFromJoint (robot->getJointByName ("root"), wall);
+  BOOST_CHECK (validate (robot, problem.configValidations (), q));
+  ValidationContexts_t contexts (problem.validationContexts (2));
+  for (ValidationContexts_t::const_iterator it = contexts.begin ();
+       it != contexts.end (); ++it) {
+    BOOST_CHECK (validate ((*it)->robot (), (*it)->configValidations (), q));
+  }
+}
+
+BOOST_AUTO_TEST_CASE (concurrentVerdicts)
+{
+  DevicePtr_t robot = createRobot ();
+  Problem problem (robot);
+  problem.addObstacle (createWall ());
+  BasicConfigurationShooterPtr_t shooter
+    (BasicConfigurationShooter::create (robot));
+  Configuration_t q0 (2);
+  q0 << -2, 0;
+  std::vector <PathPtr_t> paths;
+  std::vector <int> expected;
+  for (std::size_t i = 0; i < 100; ++i) {
+    ConfigurationPtr_t q = shooter->shoot ();
+    paths.push_back ((*problem.steeringMethod ()) (q0, *q));
+    PathPtr_t validPart;
+    PathValidationReportPtr_t report;
+    expected.push_back (problem.pathValidation ()->validate
+			(paths.back (), false, validPart, report));
+  }
+  // The same paths are validated in each context at the same time.
+  const std::size_t n = 3;
+  ValidationContexts_t contexts (problem.validationContexts (n));
+  std::vector <std::vector <int> > verdicts
+    (n, std::vector <int> (paths.size ()));
+  boost::thread_group threads;
+  for (std::size_t i = 0; i < n; ++i) {
+    threads.create_thread (boost::bind (&validatePaths, contexts [i], &paths,
+					&verdicts [i]));
+  }
+  threads.join_all ();
+  for (std::size_t i = 0; i < n; ++i) {
+    BOOST_CHECK (verdicts [i] == expected);
+  }
+}
+BOOST_AUTO_TEST_SUITE_END()